@@ -0,0 +1,113 @@
+// Entity pool benchmark: times whole simulation ticks on mine-heavy and
+// drone-heavy generated levels with a growing number of entities, where the
+// per type update loops dominate the tick. The cost per entity is the tick
+// time above the empty level's, divided by the entity count.
+//
+// The benchmark only uses the long-standing Simulation API, so the same file
+// can time builds before and after a change to entity storage.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-pool-bench [ticks]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "entities/toggle_mine.hpp"
+#include "entities/drone_zap.hpp"
+#include "entities/drone_chaser.hpp"
+#include "entities/mini_drone.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  struct EntityMix
+  {
+    const char *name;
+    std::vector<int> types; // Entity types drawn from, with repetitions as weights
+  };
+
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Positions are in
+  // units of 6 pixels. Only the border is solid, so the entities move freely.
+  std::vector<uint8_t> makeLevel(const EntityMix &mix, int entities, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      mapData[184 + i] = i % 42 == 0 || i % 42 == 41 || i / 42 == 0 || i / 42 == 22 ? 1 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    for (int i = 0; i < entities; ++i)
+    {
+      uint8_t type = mix.types[rng() % mix.types.size()];
+      uint8_t x = 8 + rng() % 156, y = 8 + rng() % 80, orientation = 2 * (rng() % 4), mode = rng() % 2;
+      mapData.insert(mapData.end(), {type, x, y, orientation, mode});
+    }
+    return mapData;
+  }
+
+  // Random held inputs, restarting the level whenever the ninja dies
+  double timeTicks(Simulation &sim, int ticks)
+  {
+    std::mt19937 rng(42);
+    int hor = 0, jump = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; ++i)
+    {
+      if (i % 13 == 0)
+      {
+        hor = static_cast<int>(rng() % 3) - 1;
+        jump = rng() % 2;
+      }
+      sim.tick(hor, jump);
+      if (sim.getNinja()->hasDied())
+      {
+        sim.reset();
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int ticks = argc > 1 ? std::atoi(argv[1]) : 50000;
+
+  // Mines of both initial states, and the three drone types
+  const EntityMix mixes[] = {
+      {"mines", {ToggleMine::ENTITY_TYPE, 21}},
+      {"drones", {DroneZap::ENTITY_TYPE, DroneChaser::ENTITY_TYPE, MiniDrone::ENTITY_TYPE}},
+  };
+
+  SimConfig config;
+  std::printf("%8s %8s %14s %14s\n", "level", "entities", "tick", "per entity");
+  for (const auto &mix : mixes)
+  {
+    double emptyNs = 0;
+    for (int entities : {0, 32, 64, 128, 256})
+    {
+      Simulation sim(config);
+      sim.load(makeLevel(mix, entities, 1234));
+      double tickNs = timeTicks(sim, ticks);
+      if (entities == 0)
+      {
+        emptyNs = tickNs;
+        std::printf("%8s %8d %11.1f ns %14s\n", mix.name, entities, tickNs, "-");
+      }
+      else
+      {
+        std::printf("%8s %8d %11.1f ns %11.2f ns\n", mix.name, entities, tickNs, (tickNs - emptyNs) / entities);
+      }
+    }
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+// Precision benchmark: times whole simulation ticks on generated levels and
+// records the ninja's trajectory, so that the float build can be compared
+// against the double precision reference build (NCLONE_DOUBLE_PRECISION).
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run:
+//   nclone-precision-bench-double [ticks] --trace double.trace
+//   nclone-precision-bench [ticks] --trace float.trace --compare double.trace
+// Both variants replay the same inputs, so the comparison reports how far and
+// how soon the float trajectories drift from the reference ones.
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+  constexpr int DENSITIES[] = {0, 10, 20, 30};
+  constexpr int LEVEL_COUNT = sizeof(DENSITIES) / sizeof(DENSITIES[0]);
+
+  // Position of the ninja after a tick, and how many times it died so far
+  struct Sample
+  {
+    double xpos, ypos;
+    int64_t deaths;
+  };
+
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 in units of 6 pixels. The cells around the spawn are left empty so
+  // the ninja does not start stuck in a tile.
+  std::vector<uint8_t> makeLevel(int fullTilePercent, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      int roll = rng() % 100;
+      bool nearSpawn = i % 42 >= 2 && i % 42 <= 6 && i / 42 >= 2 && i / 42 <= 6;
+      mapData[184 + i] = nearSpawn ? 0 : roll < fullTilePercent ? 1 : roll < fullTilePercent * 3 / 2 ? 2 + rng() % 32 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    return mapData;
+  }
+
+  // Random held inputs, restarting the level whenever the ninja dies. The
+  // inputs do not depend on the simulation, so both builds replay them alike.
+  std::vector<Sample> run(Simulation &sim, int ticks, double &tickNs)
+  {
+    std::vector<Sample> trace;
+    trace.reserve(ticks);
+    std::mt19937 rng(42);
+    int hor = 0, jump = 0;
+    int64_t deaths = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; ++i)
+    {
+      if (i % 13 == 0)
+      {
+        hor = static_cast<int>(rng() % 3) - 1;
+        jump = rng() % 2;
+      }
+      sim.tick(hor, jump);
+      if (sim.getNinja()->hasDied())
+      {
+        sim.reset();
+        ++deaths;
+      }
+      trace.push_back({sim.getNinja()->xpos, sim.getNinja()->ypos, deaths});
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    tickNs = std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+    return trace;
+  }
+
+  void writeTrace(const std::string &path, const std::vector<std::vector<Sample>> &traces)
+  {
+    std::ofstream file(path, std::ios::binary);
+    for (const auto &trace : traces)
+    {
+      uint32_t ticks = trace.size();
+      file.write(reinterpret_cast<const char *>(&ticks), sizeof(ticks));
+      file.write(reinterpret_cast<const char *>(trace.data()), ticks * sizeof(Sample));
+    }
+    if (!file)
+    {
+      throw std::runtime_error("Could not write trace " + path);
+    }
+  }
+
+  std::vector<std::vector<Sample>> readTrace(const std::string &path)
+  {
+    std::ifstream file(path, std::ios::binary);
+    std::vector<std::vector<Sample>> traces(LEVEL_COUNT);
+    for (auto &trace : traces)
+    {
+      uint32_t ticks = 0;
+      file.read(reinterpret_cast<char *>(&ticks), sizeof(ticks));
+      trace.resize(ticks);
+      file.read(reinterpret_cast<char *>(trace.data()), ticks * sizeof(Sample));
+    }
+    if (!file)
+    {
+      throw std::runtime_error("Could not read trace " + path);
+    }
+    return traces;
+  }
+
+  // Largest distance between the two trajectories, and the first ticks at
+  // which they are a hundredth of a pixel and a pixel apart
+  void reportDivergence(int density, const std::vector<Sample> &trace, const std::vector<Sample> &reference)
+  {
+    size_t ticks = std::min(trace.size(), reference.size());
+    double maxDist = 0;
+    long firstSmall = -1, firstLarge = -1;
+    for (size_t i = 0; i < ticks; ++i)
+    {
+      double dist = std::hypot(trace[i].xpos - reference[i].xpos, trace[i].ypos - reference[i].ypos);
+      maxDist = std::max(maxDist, dist);
+      if (firstSmall < 0 && dist > 0.01)
+      {
+        firstSmall = i;
+      }
+      if (firstLarge < 0 && dist > 1)
+      {
+        firstLarge = i;
+      }
+    }
+    long deaths = ticks ? trace[ticks - 1].deaths : 0;
+    long referenceDeaths = ticks ? reference[ticks - 1].deaths : 0;
+    std::printf("%7d%% %14.4f px %14ld %14ld %9ld/%ld\n", density, maxDist, firstSmall, firstLarge,
+                deaths, referenceDeaths);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int ticks = 200000;
+  std::string tracePath, comparePath;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+    {
+      tracePath = argv[++i];
+    }
+    else if (std::strcmp(argv[i], "--compare") == 0 && i + 1 < argc)
+    {
+      comparePath = argv[++i];
+    }
+    else
+    {
+      ticks = std::atoi(argv[i]);
+    }
+  }
+
+  SimConfig config;
+  std::vector<std::vector<Sample>> traces;
+  std::printf("%zu byte Real\n", sizeof(Real));
+  std::printf("%8s %16s\n", "density", "tick");
+  for (int density : DENSITIES)
+  {
+    Simulation sim(config);
+    sim.load(makeLevel(density, 1234));
+
+    double tickNs = 0;
+    traces.push_back(run(sim, ticks, tickNs));
+    std::printf("%7d%% %13.1f ns\n", density, tickNs);
+  }
+
+  if (!tracePath.empty())
+  {
+    writeTrace(tracePath, traces);
+  }
+
+  if (!comparePath.empty())
+  {
+    auto references = readTrace(comparePath);
+    std::printf("\nDivergence from %s (-1: never)\n", comparePath.c_str());
+    std::printf("%8s %17s %14s %14s %13s\n", "density", "max distance", "> 0.01 px", "> 1 px", "deaths");
+    for (int level = 0; level < LEVEL_COUNT; ++level)
+    {
+      reportDivergence(DENSITIES[level], traces[level], references[level]);
+    }
+  }
+  return 0;
+}
\ No newline at end of file
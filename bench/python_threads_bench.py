@@ -0,0 +1,111 @@
+"""Python threading benchmark: one environment per Python thread.
+
+Every thread ticks its own NPlayHeadlessCpp and exports its state vector each
+frame, like a threaded environment runner. The bindings release the GIL
+around those calls, so the throughput should grow with the thread count up to
+the number of CPUs. With --vec, every thread steps its own NPlayVecCpp batch
+instead.
+
+Build and install the bindings (see README), then run:
+  python bench/python_threads_bench.py [--frames N] [--max-threads N] [--vec]
+"""
+
+import argparse
+import os
+import random
+import threading
+import time
+
+import numpy as np
+
+from nplay_headless_cpp import NPlayHeadlessCpp, NPlayVecCpp
+
+
+def make_level(seed, full_tile_percent=10):
+    """Tiles of the 42x23 playable area start at byte 184, the ninja spawn is
+    at 1231. The cells around the spawn are left empty so the ninja does not
+    start stuck in a tile."""
+    rng = random.Random(seed)
+    map_data = bytearray(1235)
+    for i in range(42 * 23):
+        roll = rng.randrange(100)
+        near_spawn = 2 <= i % 42 <= 6 and 2 <= i // 42 <= 6
+        if not near_spawn and roll < full_tile_percent:
+            map_data[184 + i] = 1
+        elif not near_spawn and roll < full_tile_percent * 3 // 2:
+            map_data[184 + i] = 2 + rng.randrange(32)
+    map_data[1231] = 20
+    map_data[1232] = 20
+    return bytes(map_data)
+
+
+def run_env(seed, frames):
+    """Random held inputs, restarting the level whenever the ninja dies."""
+    sim = NPlayHeadlessCpp(enable_anim=False)
+    sim.load_map(make_level(seed))
+    rng = random.Random(seed)
+    hor, jump = 0, 0
+    for frame in range(frames):
+        if frame % 13 == 0:
+            hor, jump = rng.randint(-1, 1), rng.randint(0, 1)
+        sim.tick(hor, jump)
+        sim.get_state_vector()
+        if sim.has_died():
+            sim.reset()
+
+
+def run_vec(seed, frames, num_envs):
+    vec = NPlayVecCpp(num_envs)
+    vec.load_map(make_level(seed))
+    rng = np.random.default_rng(seed)
+    actions = np.zeros((num_envs, 2), dtype=np.int32)
+    observations = np.empty((num_envs, vec.observation_size), dtype=np.float32)
+    rewards = np.empty(num_envs, dtype=np.float32)
+    dones = np.empty(num_envs, dtype=np.uint8)
+    for frame in range(frames):
+        if frame % 13 == 0:
+            actions[:, 0] = rng.integers(-1, 2, num_envs)
+            actions[:, 1] = rng.integers(0, 2, num_envs)
+        vec.step(actions, observations, rewards, dones)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--frames", type=int, default=20000, help="frames per thread")
+    parser.add_argument("--max-threads", type=int, default=os.cpu_count() or 1)
+    parser.add_argument("--vec", action="store_true", help="step an NPlayVecCpp batch per thread")
+    parser.add_argument("--vec-envs", type=int, default=64, help="simulations per batch with --vec")
+    args = parser.parse_args()
+
+    if args.vec:
+        frames = max(1, args.frames // args.vec_envs)
+        envs_per_thread = args.vec_envs
+
+        def worker(seed):
+            run_vec(seed, frames, envs_per_thread)
+    else:
+        frames = args.frames
+        envs_per_thread = 1
+
+        def worker(seed):
+            run_env(seed, frames)
+
+    print(f"{os.cpu_count()} CPUs, {frames} frames of {envs_per_thread} simulation(s) per thread")
+    print(f"{'threads':>8} {'env-steps/s':>16} {'speedup':>10}")
+    serial_rate = None
+    threads = 1
+    while threads <= args.max_threads:
+        workers = [threading.Thread(target=worker, args=(seed,)) for seed in range(threads)]
+        start = time.perf_counter()
+        for thread in workers:
+            thread.start()
+        for thread in workers:
+            thread.join()
+        rate = threads * frames * envs_per_thread / (time.perf_counter() - start)
+        serial_rate = serial_rate or rate
+        print(f"{threads:>8} {rate:>16.0f} {rate / serial_rate:>9.2f}x")
+        threads *= 2
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,84 @@
+// Raycast microbenchmark: times Physics::raycastVsPlayer (the thwump line of
+// sight test) and full-length Physics::getRaycastDistance walks on generated
+// levels of increasing tile density.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-raycast-bench [rays]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "physics/physics.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at 1231
+  std::vector<uint8_t> makeLevel(int fullTilePercent, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      int roll = rng() % 100;
+      mapData[184 + i] = roll < fullTilePercent ? 1 : roll < fullTilePercent * 3 / 2 ? 2 + rng() % 32 : 0;
+    }
+    mapData[1231] = 10;
+    mapData[1232] = 10;
+    return mapData;
+  }
+
+  template <typename Cast>
+  double timeRays(int rays, Cast &&cast)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < rays; ++i)
+    {
+      cast(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / rays;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int rays = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+  SimConfig config;
+  std::printf("%8s %18s %18s\n", "density", "line of sight", "full ray");
+  for (int density : {0, 5, 10, 20, 40})
+  {
+    Simulation sim(config);
+    sim.load(makeLevel(density, 1234));
+
+    // Endpoints inside the map, generated up front so only the casts are timed
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> xdist(24, 1032), ydist(24, 576);
+    std::vector<float> points;
+    for (int i = 0; i < 4096; ++i)
+    {
+      points.insert(points.end(), {xdist(rng), ydist(rng), xdist(rng), ydist(rng)});
+    }
+
+    int hits = 0;
+    auto endpoint = [&](int i)
+    { return &points[(i % 4096) * 4]; };
+    double sightNs = timeRays(rays, [&](int i)
+                              {
+      const float *p = endpoint(i);
+      hits += Physics::raycastVsPlayer(sim, p[0], p[1], p[2], p[3], 10.0f); });
+    double fullNs = timeRays(rays, [&](int i)
+                             {
+      const float *p = endpoint(i);
+      hits += Physics::getRaycastDistance(sim, p[0], p[1], p[2] - p[0], p[3] - p[1]).has_value(); });
+
+    std::printf("%7d%% %15.1f ns %15.1f ns   (%d hits)\n", density, sightNs, fullNs, hits);
+  }
+  return 0;
+}
\ No newline at end of file
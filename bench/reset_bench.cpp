@@ -0,0 +1,89 @@
+// Reset benchmark: times Simulation::reset(), which restores the state
+// captured after the map entities were loaded, against loading the same
+// compiled map again, which recreates the ninja and the entities from the map
+// data the way reset() used to. Loading also captures the new initial state,
+// which the old reset did not, so the speedup is somewhat overstated.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-reset-bench [resets]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "compiled_map.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Positions are in
+  // units of 6 pixels. Locked and trap doors get a switch record after them.
+  std::vector<uint8_t> makeLevel(int entities, unsigned seed)
+  {
+    const int types[] = {1, 2, 2, 5, 6, 8, 10, 11, 14, 17, 20, 21, 24, 25, 26, 28};
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      mapData[184 + i] = rng() % 100 < 10 ? 1 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    for (int i = 0; i < entities; ++i)
+    {
+      uint8_t type = types[rng() % std::size(types)];
+      uint8_t x = 8 + rng() % 156, y = 8 + rng() % 80, orientation = 2 * (rng() % 4), mode = rng() % 2;
+      mapData.insert(mapData.end(), {type, x, y, orientation, mode});
+      if (type == 6 || type == 8)
+      {
+        mapData.insert(mapData.end(), {0, static_cast<uint8_t>(8 + rng() % 156), static_cast<uint8_t>(8 + rng() % 80), 0, 0});
+      }
+    }
+    return mapData;
+  }
+
+  template <typename Reset>
+  double timeResets(Simulation &sim, int resets, Reset &&reset)
+  {
+    // Move the simulation away from its initial state first
+    for (int i = 0; i < 60; ++i)
+    {
+      sim.tick(1, i % 20 < 10);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < resets; ++i)
+    {
+      reset();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / resets;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int resets = argc > 1 ? std::atoi(argv[1]) : 100000;
+
+  SimConfig config;
+  std::printf("%8s %14s %14s %10s\n", "entities", "reset", "reload", "speedup");
+  for (int entities : {0, 16, 64, 256})
+  {
+    auto map = CompiledMap::getShared(makeLevel(entities, 1234));
+    Simulation sim(config);
+    sim.load(map);
+
+    double resetNs = timeResets(sim, resets, [&]
+                                { sim.reset(); });
+    double reloadNs = timeResets(sim, resets, [&]
+                                 { sim.load(map); });
+    std::printf("%8d %11.1f ns %11.1f ns %9.2fx\n", entities, resetNs, reloadNs, reloadNs / resetNs);
+  }
+  return 0;
+}
\ No newline at end of file
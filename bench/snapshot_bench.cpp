@@ -0,0 +1,94 @@
+// Snapshot benchmark: times Simulation::snapshot() into a reused state and
+// Simulation::restore() from it, the two halves of a branch in a tree search,
+// on generated levels with a growing number of entities. A tick is timed too,
+// for scale.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-snapshot-bench [iterations]
+
+#include "simulation.hpp"
+#include "simulation_state.hpp"
+#include "sim_config.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Positions are in
+  // units of 6 pixels. Locked and trap doors get a switch record after them.
+  std::vector<uint8_t> makeLevel(int entities, unsigned seed)
+  {
+    const int types[] = {1, 2, 2, 5, 6, 8, 10, 11, 14, 17, 20, 21, 24, 25, 26, 28};
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      mapData[184 + i] = rng() % 100 < 10 ? 1 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    for (int i = 0; i < entities; ++i)
+    {
+      uint8_t type = types[rng() % std::size(types)];
+      uint8_t x = 8 + rng() % 156, y = 8 + rng() % 80, orientation = 2 * (rng() % 4), mode = rng() % 2;
+      mapData.insert(mapData.end(), {type, x, y, orientation, mode});
+      if (type == 6 || type == 8)
+      {
+        mapData.insert(mapData.end(), {0, static_cast<uint8_t>(8 + rng() % 156), static_cast<uint8_t>(8 + rng() % 80), 0, 0});
+      }
+    }
+    return mapData;
+  }
+
+  template <typename Operation>
+  double timeOperation(int iterations, Operation &&operation)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i)
+    {
+      operation(i);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / iterations;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int iterations = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+  SimConfig config;
+  std::printf("%8s %14s %14s %14s\n", "entities", "snapshot", "restore", "tick");
+  for (int entities : {0, 16, 64, 256})
+  {
+    Simulation sim(config);
+    sim.load(makeLevel(entities, 1234));
+    for (int i = 0; i < 60; ++i)
+    {
+      sim.tick(1, i % 20 < 10);
+    }
+
+    // The first snapshot grows the state's buffers, later ones reuse them
+    SimulationState state;
+    sim.snapshot(state);
+
+    double snapshotNs = timeOperation(iterations, [&](int)
+                                      { sim.snapshot(state); });
+    double restoreNs = timeOperation(iterations, [&](int)
+                                     { sim.restore(state); });
+    // Every tick starts from the snapshot, like the children of a search node
+    double tickNs = timeOperation(iterations / 10, [&](int i)
+                                  {
+      sim.tick(i % 3 - 1, i / 3 % 2);
+      sim.restore(state); }) - restoreNs;
+    std::printf("%8d %11.1f ns %11.1f ns %11.1f ns\n", entities, snapshotNs, restoreNs, tickNs);
+  }
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+// Thwump microbenchmark: times whole simulation ticks on generated levels
+// crowded with thwumps, whose idle think runs the line of sight raycast
+// whenever the ninja is in front of them.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-thwump-bench [ticks]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "physics/physics.hpp"
+#include "entities/thwump.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+namespace
+{
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Entity coordinates
+  // are loaded as pixels, so the thwumps crowd around the spawn.
+  std::vector<uint8_t> makeLevel(int fullTilePercent, int thwumps, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      int roll = rng() % 100;
+      mapData[184 + i] = roll < fullTilePercent ? 1 : roll < fullTilePercent * 3 / 2 ? 2 + rng() % 32 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    for (int i = 0; i < thwumps; ++i)
+    {
+      uint8_t x = 8 + rng() % 240, y = 8 + rng() % 240, orientation = 2 * (rng() % 4);
+      mapData.insert(mapData.end(), {Thwump::ENTITY_TYPE, x, y, orientation, 0});
+    }
+    return mapData;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int ticks = argc > 1 ? std::atoi(argv[1]) : 200000;
+
+  SimConfig config;
+  std::printf("%8s %10s %16s %12s\n", "density", "thwumps", "tick", "static sight");
+  for (int density : {0, 10, 20})
+  {
+    Simulation sim(config);
+    sim.load(makeLevel(density, Thwump::MAX_COUNT_PER_LEVEL, 1234));
+
+    int staticSight = 0;
+    for (auto *entity : sim.getEntitiesOfType(Thwump::ENTITY_TYPE))
+    {
+      staticSight += Physics::isRaycastVsPlayerStatic(sim, entity->getXPos(), entity->getYPos());
+    }
+
+    // Random held inputs, restarting the level whenever the ninja dies
+    std::mt19937 rng(42);
+    int hor = 0, jump = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; ++i)
+    {
+      if (i % 13 == 0)
+      {
+        hor = static_cast<int>(rng() % 3) - 1;
+        jump = rng() % 2;
+      }
+      sim.tick(hor, jump);
+      if (sim.getNinja()->hasDied())
+      {
+        sim.reset();
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double tickNs = std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+
+    std::printf("%7d%% %10d %13.1f ns %8d/%d\n", density, Thwump::MAX_COUNT_PER_LEVEL, tickNs,
+                staticSight, Thwump::MAX_COUNT_PER_LEVEL);
+  }
+  return 0;
+}
\ No newline at end of file
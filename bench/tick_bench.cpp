@@ -0,0 +1,184 @@
+// Tick benchmark: times whole simulation ticks over a corpus of generated
+// levels (tile density times entity mix), and the cell lookups of the hot
+// path against the hash maps keyed by cell coordinate they replaced.
+//
+// The lookup table shows the per lookup gain of the dense grids in one
+// binary. For the per tick speedup, run the tick table on builds of the
+// revisions before and after a change; it only uses the long-standing
+// Simulation API.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-tick-bench [ticks] [lookups]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  struct EntityMix
+  {
+    const char *name;
+    std::vector<int> types; // Entity types drawn from, with repetitions as weights
+    int count;
+  };
+
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Positions are in
+  // units of 6 pixels. The cells around the spawn are kept empty.
+  std::vector<uint8_t> makeLevel(int fullTilePercent, const EntityMix &mix, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      int x = i % 42, y = i / 42;
+      bool spawn = x >= 2 && x <= 6 && y >= 2 && y <= 6;
+      int roll = rng() % 100;
+      mapData[184 + i] = spawn ? 0 : roll < fullTilePercent ? 1 : roll < fullTilePercent * 3 / 2 ? 2 + rng() % 32 : 0;
+    }
+    mapData[1231] = 18;
+    mapData[1232] = 18;
+    for (int i = 0; i < mix.count; ++i)
+    {
+      uint8_t type = mix.types[rng() % mix.types.size()];
+      uint8_t x = 8 + rng() % 156, y = 8 + rng() % 80, orientation = 2 * (rng() % 4), mode = rng() % 2;
+      mapData.insert(mapData.end(), {type, x, y, orientation, mode});
+    }
+    return mapData;
+  }
+
+  // Random held inputs, restarting the level whenever the ninja dies or wins
+  double timeTicks(Simulation &sim, int ticks)
+  {
+    std::mt19937 rng(42);
+    int hor = 0, jump = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ticks; ++i)
+    {
+      if (i % 13 == 0)
+      {
+        hor = static_cast<int>(rng() % 3) - 1;
+        jump = rng() % 2;
+      }
+      sim.tick(hor, jump);
+      if (sim.getNinja()->hasDied() || sim.getNinja()->hasWon())
+      {
+        sim.reset();
+      }
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ticks;
+  }
+
+  // The hash the cell maps used before they became dense grids
+  struct CellCoordHash
+  {
+    size_t operator()(const CellCoord &cell) const
+    {
+      return std::hash<int>()(cell.first) ^ (std::hash<int>()(cell.second) << 1);
+    }
+  };
+
+  template <typename Lookup>
+  double timeLookups(const std::vector<CellCoord> &cells, Lookup &&lookup, long &sink)
+  {
+    auto start = std::chrono::steady_clock::now();
+    for (const auto &cell : cells)
+    {
+      sink += lookup(cell);
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / cells.size();
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int ticks = argc > 1 ? std::atoi(argv[1]) : 100000;
+  int lookups = argc > 2 ? std::atoi(argv[2]) : 10000000;
+
+  const std::vector<EntityMix> mixes = {
+      {"none", {}, 0},
+      {"gold", {2}, 64},
+      {"mines", {1, 21}, 96},
+      {"drones", {14, 15, 26}, 48},
+      {"mixed", {1, 2, 5, 6, 10, 11, 14, 17, 20, 21, 24, 25, 26, 28}, 64},
+  };
+
+  SimConfig config;
+  std::printf("%8s %8s %12s\n", "density", "entities", "tick");
+  double totalNs = 0;
+  int levels = 0;
+  for (int density : {0, 10, 20, 40})
+  {
+    for (const auto &mix : mixes)
+    {
+      Simulation sim(config);
+      sim.load(makeLevel(density, mix, 1234));
+      double tickNs = timeTicks(sim, ticks);
+      totalNs += tickNs;
+      ++levels;
+      std::printf("%7d%% %8s %9.1f ns\n", density, mix.name, tickNs);
+    }
+  }
+  std::printf("%17s %9.1f ns\n", "corpus mean", totalNs / levels);
+
+  // Copy the cell data of one level into hash maps and look up the same
+  // random cells in both
+  Simulation sim(config);
+  sim.load(makeLevel(20, mixes.back(), 1234));
+  std::unordered_map<CellCoord, int, CellCoordHash> tileMap;
+  std::unordered_map<CellCoord, Simulation::EntityList, CellCoordHash> entityMap;
+  std::unordered_map<CellCoord, bool, CellCoordHash> edgeMap;
+  for (int x = 0; x < 44; ++x)
+  {
+    for (int y = 0; y < 25; ++y)
+    {
+      tileMap[{x, y}] = sim.getTileAt(x, y);
+      entityMap[{x, y}] = sim.getEntitiesAt({x, y});
+      edgeMap[{x, y}] = sim.hasHorizontalEdge({x, y});
+    }
+  }
+
+  std::mt19937 rng(7);
+  std::vector<CellCoord> cells(lookups);
+  for (auto &cell : cells)
+  {
+    cell = {static_cast<int>(rng() % 44), static_cast<int>(rng() % 25)};
+  }
+
+  long sink = 0;
+  std::printf("\n%10s %12s %12s %10s\n", "lookup", "grid", "hash map", "speedup");
+  auto report = [&](const char *name, double gridNs, double hashNs)
+  {
+    std::printf("%10s %9.2f ns %9.2f ns %9.2fx\n", name, gridNs, hashNs, hashNs / gridNs);
+  };
+  report("tile",
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return sim.getTileAt(cell.first, cell.second); }, sink),
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return tileMap.at(cell); }, sink));
+  report("entities",
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return static_cast<int>(sim.getEntitiesAt(cell).size()); }, sink),
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return static_cast<int>(entityMap.at(cell).size()); }, sink));
+  report("edge",
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return static_cast<int>(sim.hasHorizontalEdge(cell)); }, sink),
+         timeLookups(cells, [&](const CellCoord &cell)
+                     { return static_cast<int>(edgeMap.at(cell)); }, sink));
+
+  // Keep the lookups from being optimized away
+  return sink == 42 ? 1 : 0;
+}
\ No newline at end of file
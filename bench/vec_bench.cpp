@@ -0,0 +1,126 @@
+// VecSimulation scaling benchmark: steps a batch of simulations on 1 to 64
+// threads of the work stealing pool. Every other level is crowded with zap
+// drones and the rest are empty, so the per simulation cost is uneven and the
+// workers that finish their own range first have to steal.
+//
+// Configure with -DNCLONE_BUILD_BENCHMARKS=ON -DCMAKE_BUILD_TYPE=Release, then
+// run: nclone-vec-bench [steps] [simulations] [--pin]
+// Thread counts above the CPU count only show the cost of oversubscription.
+
+#include "vec_simulation.hpp"
+#include "sim_config.hpp"
+#include "entities/drone_zap.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // Tiles of the 42x23 playable area start at byte 184, the ninja spawn is at
+  // 1231 and entity records of 5 bytes follow from 1235. Entity coordinates
+  // are loaded as pixels.
+  std::vector<uint8_t> makeLevel(int drones, unsigned seed)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    for (int i = 0; i < 42 * 23; ++i)
+    {
+      bool border = i % 42 == 0 || i % 42 == 41 || i / 42 == 0 || i / 42 == 22;
+      mapData[184 + i] = border || rng() % 100 < 5 ? 1 : 0;
+    }
+    mapData[1231] = 20;
+    mapData[1232] = 20;
+    for (int i = 0; i < drones; ++i)
+    {
+      uint8_t x = 8 + rng() % 240, y = 8 + rng() % 120, orientation = 2 * (rng() % 4);
+      mapData.insert(mapData.end(), {DroneZap::ENTITY_TYPE, x, y, orientation, 0});
+    }
+    return mapData;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int steps = 2000, count = 512;
+  bool pin = false;
+  int positional = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    if (std::strcmp(argv[i], "--pin") == 0)
+    {
+      pin = true;
+    }
+    else if (positional++ == 0)
+    {
+      steps = std::atoi(argv[i]);
+    }
+    else
+    {
+      count = std::atoi(argv[i]);
+    }
+  }
+
+  SimConfig config;
+  VecSimulation vec(count, config);
+  auto empty = makeLevel(0, 1234);
+  auto crowded = makeLevel(64, 1234);
+  for (int i = 0; i < count; ++i)
+  {
+    vec.loadMap(i, i % 2 ? crowded : empty);
+  }
+
+  std::vector<int32_t> actions(count * 2);
+  std::vector<float> observations(static_cast<size_t>(count) * vec.getObservationSize());
+  std::vector<float> rewards(count);
+  std::vector<uint8_t> dones(count);
+
+  std::printf("%d simulations, %u CPUs%s\n", count, std::thread::hardware_concurrency(), pin ? ", pinned" : "");
+  std::printf("%8s %18s %10s %12s %10s\n", "threads", "steps/s", "speedup", "utilization", "steals");
+  double serialRate = 0;
+  for (int threads = 1; threads <= 64; threads *= 2)
+  {
+    vec.setThreads(threads, pin);
+    vec.reset();
+
+    // Random held inputs, the same for every thread count
+    std::mt19937 rng(42);
+    auto start = std::chrono::steady_clock::now();
+    for (int step = 0; step < steps; ++step)
+    {
+      if (step % 13 == 0)
+      {
+        for (int i = 0; i < count; ++i)
+        {
+          actions[2 * i] = static_cast<int>(rng() % 3) - 1;
+          actions[2 * i + 1] = rng() % 2;
+        }
+      }
+      vec.step(actions.data(), observations.data(), rewards.data(), dones.data());
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double rate = static_cast<double>(steps) * count / std::chrono::duration<double>(elapsed).count();
+    if (threads == 1)
+    {
+      serialRate = rate;
+    }
+
+    const auto &pool = vec.getThreadPool();
+    double busyNs = 0;
+    uint64_t steals = 0;
+    for (const auto &stats : pool.getWorkerStats())
+    {
+      busyNs += stats.busyNs;
+      steals += stats.steals;
+    }
+    double utilization = busyNs / threads / pool.getWallNs();
+    std::printf("%8d %18.0f %9.2fx %11.1f%% %10llu\n", threads, rate, rate / serialRate, 100 * utilization,
+                static_cast<unsigned long long>(steals));
+  }
+  return 0;
+}
\ No newline at end of file
@@ -3,6 +3,7 @@ from Cython.Build import cythonize
 import numpy as np
 import os
 import subprocess
+import sys
 
 # Run CMake build first
 subprocess.check_call(['make', 'cpp'], cwd='..')
@@ -25,13 +26,20 @@ def get_cpp_sources():
         "../src/sim_wrapper.cpp",
         "../src/renderer.cpp",
         "../src/simulation.cpp",
+        "../src/compiled_map.cpp",
         "../src/ninja.cpp",
         "../src/sim_config.cpp",
+        "../src/observation.cpp",
+        "../src/vec_simulation.cpp",
+        "../src/work_stealing_pool.cpp",
         "../src/tilemap.cpp",
         "../src/entity_renderer.cpp",
         "../src/ninja_renderer.cpp",
         "../src/physics/physics.cpp",
-        "../src/physics/segment.cpp",
+        "../src/physics/segment_store.cpp",
+        "../src/physics/clearance_field.cpp",
+        "../src/physics/linear_sweep.cpp",
+        "../src/physics/segment_cache.cpp",
         "../src/physics/grid_segment_linear.cpp",
         "../src/physics/grid_segment_circular.cpp",
         "../src/entities/boost_pad.cpp",
@@ -70,16 +78,36 @@ extension = Extension(
         'sfml-system-d'
     ],
     language="c++",
-    extra_compile_args=["-std=c++17"],
+    extra_compile_args=["-std=c++17", "-pthread",
+                        "-ffp-contract=off"],  # No fused multiply-add, as in the CMake build
+    extra_link_args=["-pthread"],  # VecSimulation worker threads
     runtime_library_dirs=[os.path.abspath("../build/_deps/sfml-build/lib")]  # Help find SFML libs at runtime
 )
+extensions = [extension]
+
+# The environment server client uses POSIX shared memory and futexes, so it is
+# only built on Linux
+if sys.platform.startswith("linux"):
+    extensions.append(Extension(
+        "nplay_headless_cpp.nplay_shm_client",
+        sources=[
+            "src/nplay_headless_cpp/nplay_shm_client.pyx",
+            "../src/env_client.cpp",
+            "../src/shm_env.cpp"
+        ],
+        include_dirs=["../src", np.get_include()],
+        libraries=['rt'],  # shm_open
+        language="c++",
+        extra_compile_args=["-std=c++17", "-pthread"],
+        extra_link_args=["-pthread"]
+    ))
 
 setup(
     name="nplay_headless_cpp",
     version="0.0.1",
     description="Wrapper for NClone-CPP",
     ext_modules=cythonize(
-        [extension],
+        extensions,
         language_level=3,
         compiler_directives={"linetrace": True}
     ),
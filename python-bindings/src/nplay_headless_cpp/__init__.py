@@ -2,6 +2,13 @@
 Python bindings for the NClone-CPP simulation.
 """
 
-from .nplay_headless_cpp import NPlayHeadlessCpp
+import sys
 
-__all__ = ['NPlayHeadlessCpp']
+from .nplay_headless_cpp import NPlayHeadlessCpp, NPlayVecCpp
+
+__all__ = ['NPlayHeadlessCpp', 'NPlayVecCpp']
+
+# The environment server client is only built on Linux
+if sys.platform.startswith("linux"):
+    from .nplay_shm_client import NPlayShmClient
+    __all__.append('NPlayShmClient')
@@ -7,19 +7,31 @@ from libcpp.utility cimport pair
 from libcpp cimport bool
 from libcpp.memory cimport unique_ptr
 from libcpp.string cimport string
+from libc.stdint cimport uint64_t, int32_t, uint8_t
+from libc.string cimport memcpy
+from cython.operator cimport dereference as deref
+import warnings
 import numpy as np
 cimport numpy as np
 
+np.import_array()
+
 # Need to declare unsigned char for vector
 ctypedef unsigned char uchar
 
-# Declare the C++ class
-cdef extern from "sim_wrapper.hpp":
+cdef extern from "simulation_state.hpp":
+    cdef cppclass SimulationState:
+        SimulationState() except +
+
+# Declare the C++ class. Its methods do not touch Python objects, so they can run without the GIL
+cdef extern from "sim_wrapper.hpp" nogil:
     cdef cppclass SimWrapper:
         SimWrapper(bool, bool, bool, float, bool, bool, string) except +
-        void loadMap(vector[uchar]&)
-        void reset()
-        void tick(float, int)
+        void loadMap(vector[uchar]&) except +
+        void reset() except +
+        void tick(float, int) except +
+        void snapshot(SimulationState&) except +
+        void restore(const SimulationState&) except +
         bool hasWon()
         bool hasDied()
         pair[float, float] getNinjaPosition()
@@ -33,13 +45,75 @@ cdef extern from "sim_wrapper.hpp":
         bool exitSwitchActivated()
         pair[float, float] getExitSwitchPosition()
         pair[float, float] getExitDoorPosition()
+        pair[uint64_t, uint64_t] getNeighbourhoodCacheStats()
+        vector[uint64_t] getCollisionPassHistogram()
         vector[float] getNinjaState()
         vector[float] getEntityStates(bool)
         vector[float] getStateVector(bool)
-        void render(vector[float]&, vector[float]&, int, int, int, int)
+        void render(vector[float]&, vector[float]&, int, int, int, int) except +
         bool isWindowOpen()
 
-# Python wrapper class
+cdef extern from "sim_config.hpp":
+    cdef cppclass SimConfig:
+        SimConfig(bool, bool, float, bool, bool)
+
+cdef extern from "work_stealing_pool.hpp":
+    cdef cppclass WorkerStats "WorkStealingPool::WorkerStats":
+        uint64_t busyNs
+        uint64_t tasks
+        uint64_t steals
+
+    cdef cppclass WorkStealingPool:
+        int getThreadCount()
+        int getPinnedCount()
+        vector[WorkerStats] getWorkerStats()
+        uint64_t getWallNs()
+        void resetStats()
+
+cdef extern from "vec_simulation.hpp" nogil:
+    cdef cppclass VecRewards "VecSimulation::Rewards":
+        float win
+        float death
+        float gold
+
+    cdef cppclass VecStepResult "VecSimulation::StepResult":
+        const float *observations
+        const float *rewards
+        const uint8_t *dones
+
+    cdef cppclass VecSimulation:
+        VecSimulation(int, const SimConfig&, bool, const VecRewards&) except +
+        int size()
+        int getObservationSize()
+        void loadMap(int, vector[uchar]&) except +
+        void loadMap(vector[uchar]&) except +
+        void reset(int) except +
+        void reset() except +
+        void writeObservations(float*) except +
+        void step(const int32_t*, float*, float*, uint8_t*) except +
+        void stepAsync(const int32_t*) except +
+        VecStepResult stepWait() except +
+        bool isStepPending()
+        void setThreads(int, bool, int) except +
+        WorkStealingPool& getThreadPool()
+
+cdef object _buffer_view(object owner, const void *data, int ndim, np.npy_intp *shape, int type_num):
+    """Read-only array over memory that lives as long as owner."""
+    cdef np.ndarray view = np.PyArray_SimpleNewFromData(ndim, shape, type_num, <void*>data)
+    np.set_array_base(view, owner)
+    view.flags.writeable = False
+    return view
+
+cdef class SimState:
+    """Opaque copy of a simulation's dynamic state, created by NPlayHeadlessCpp.snapshot."""
+    cdef unique_ptr[SimulationState] _state
+
+    def __cinit__(self):
+        self._state.reset(new SimulationState())
+
+# Python wrapper class. Loading, ticking, rendering and exporting state
+# release the GIL, so Python threads that each drive their own instance run
+# in parallel. An instance must not be used by two threads at once.
 cdef class NPlayHeadlessCpp:
     cdef unique_ptr[SimWrapper] _sim
 
@@ -47,17 +121,40 @@ cdef class NPlayHeadlessCpp:
         self._sim.reset(new SimWrapper(enable_debug_overlay, basic_sim, full_export, tolerance, enable_anim, log_data, render_mode.encode('utf-8')))
 
     def load_map(self, bytes map_data):
-        cdef vector[uchar] cpp_map_data
-        cpp_map_data.resize(len(map_data))
-        for i in range(len(map_data)):
-            cpp_map_data[i] = map_data[i]
-        self._sim.get().loadMap(cpp_map_data)
+        cdef vector[uchar] cpp_map_data = map_data
+        with nogil:
+            self._sim.get().loadMap(cpp_map_data)
 
     def reset(self):
-        self._sim.get().reset()
+        with nogil:
+            self._sim.get().reset()
 
     def tick(self, float hor_input, int jump_input):
-        self._sim.get().tick(hor_input, jump_input)
+        with nogil:
+            self._sim.get().tick(hor_input, jump_input)
+
+    def snapshot(self, SimState state=None):
+        """Capture the dynamic simulation state for a later restore.
+
+        Passing a previously returned state reuses its buffers instead of allocating new ones.
+        """
+        if state is None:
+            state = SimState()
+        cdef SimulationState *cpp_state = state._state.get()
+        with nogil:
+            self._sim.get().snapshot(deref(cpp_state))
+        return state
+
+    def restore(self, SimState state not None):
+        """Restore a state taken from this or another simulation on the same level.
+
+        Simulations that loaded the same map data share its compiled map, and a
+        state can move between them, for instance from one search worker to
+        another. Raises ValueError for a state taken on another level.
+        """
+        cdef SimulationState *cpp_state = state._state.get()
+        with nogil:
+            self._sim.get().restore(deref(cpp_state))
 
     def has_won(self):
         return self._sim.get().hasWon()
@@ -94,19 +191,38 @@ cdef class NPlayHeadlessCpp:
     def get_sim_frame(self):
         return self._sim.get().getSimFrame()
 
+    def get_neighbourhood_cache_stats(self):
+        """Hits, misses and hit rate of the entity neighbourhood cache used by the ninja's collision passes."""
+        cdef pair[uint64_t, uint64_t] stats = self._sim.get().getNeighbourhoodCacheStats()
+        total = stats.first + stats.second
+        return {"hits": stats.first, "misses": stats.second, "hit_rate": float(stats.first) / total if total else 0.0}
+
+    def get_collision_pass_histogram(self):
+        """Number of ticks that used each count of ninja collision passes (1 to 4), and the mean count."""
+        cdef vector[uint64_t] histogram = self._sim.get().getCollisionPassHistogram()
+        ticks = sum(histogram)
+        mean = sum((i + 1) * count for i, count in enumerate(histogram)) / ticks if ticks else 0.0
+        return {"ticks": {i + 1: count for i, count in enumerate(histogram)}, "mean": mean}
+
     def get_ninja_state(self):
         """Get ninja state information as a 10-element list of floats, all normalized between 0 and 1."""
-        cdef vector[float] state = self._sim.get().getNinjaState()
+        cdef vector[float] state
+        with nogil:
+            state = self._sim.get().getNinjaState()
         return np.array(state, dtype=np.float32)
 
     def get_entity_states(self, bool only_exit_and_switch=False):
         """Get all entity states as a list of floats with fixed length, all normalized between 0 and 1."""
-        cdef vector[float] state = self._sim.get().getEntityStates(only_exit_and_switch)
+        cdef vector[float] state
+        with nogil:
+            state = self._sim.get().getEntityStates(only_exit_and_switch)
         return np.array(state, dtype=np.float32)
 
     def get_state_vector(self, bool only_exit_and_switch=False):
         """Get a complete state representation of the game environment as a vector of float values."""
-        cdef vector[float] state = self._sim.get().getStateVector(only_exit_and_switch)
+        cdef vector[float] state
+        with nogil:
+            state = self._sim.get().getStateVector(only_exit_and_switch)
         return np.array(state, dtype=np.float32)
 
     def render(self):
@@ -124,9 +240,10 @@ cdef class NPlayHeadlessCpp:
         cdef int player_width = 84
         cdef int player_height = 84
 
-        self._sim.get().render(global_buffer, player_buffer, 
-                              full_width, full_height,
-                              player_width, player_height)
+        with nogil:
+            self._sim.get().render(global_buffer, player_buffer,
+                                   full_width, full_height,
+                                   player_width, player_height)
         
         # Convert to numpy arrays with appropriate shapes
         global_view = np.array(global_buffer, dtype=np.float32).reshape(full_height, full_width, 3)
@@ -150,4 +267,140 @@ cdef class NPlayHeadlessCpp:
 
     def is_window_open(self):
         """Check if the SFML window is still open (if in human render mode)."""
-        return self._sim.get().isWindowOpen() 
\ No newline at end of file
+        return self._sim.get().isWindowOpen() 
+
+cdef class NPlayVecCpp:
+    """N headless simulations stepped together.
+
+    Each step ticks every simulation and writes the observations, rewards and
+    done flags of the whole batch into contiguous arrays in one call.
+    Simulations that are done are reset, and their observation is the first
+    one of the new episode. With num_threads other than 1 (0: one per CPU) the
+    batch is split across a pool of worker threads, optionally pinned to CPUs.
+    """
+    cdef unique_ptr[VecSimulation] _vec
+
+    def __cinit__(self, int num_envs, bool basic_sim=False, bool full_export=False, float tolerance=1.0, bool enable_anim=False, bool log_data=False, bool only_exit_and_switch=False, float win_reward=1.0, float death_reward=-1.0, float gold_reward=0.0, int num_threads=1, bool pin_threads=False, int chunk_size=0):
+        cdef VecRewards rewards
+        cdef WorkStealingPool *pool
+        rewards.win = win_reward
+        rewards.death = death_reward
+        rewards.gold = gold_reward
+        # VecSimulation keeps its own copy of the config
+        self._vec.reset(new VecSimulation(num_envs, SimConfig(basic_sim, full_export, tolerance, enable_anim, log_data), only_exit_and_switch, rewards))
+        if num_threads != 1:
+            self._vec.get().setThreads(num_threads, pin_threads, chunk_size)
+            pool = &self._vec.get().getThreadPool()
+            if pin_threads and pool.getPinnedCount() < pool.getThreadCount() - 1:
+                warnings.warn(f"Pinned {pool.getPinnedCount()} of {pool.getThreadCount() - 1} worker threads to CPUs; the others run unpinned")
+
+    @property
+    def num_envs(self):
+        return self._vec.get().size()
+
+    @property
+    def observation_size(self):
+        return self._vec.get().getObservationSize()
+
+    @property
+    def num_threads(self):
+        return self._vec.get().getThreadPool().getThreadCount()
+
+    def get_worker_stats(self, bool reset=False):
+        """Per worker busy time, tasks run, steals and utilization since the last reset."""
+        # The workers update their stats while a step_async() runs
+        if self._vec.get().isStepPending():
+            raise RuntimeError("get_worker_stats() called while an asynchronous step is pending")
+        cdef WorkStealingPool *pool = &self._vec.get().getThreadPool()
+        cdef uint64_t wall_ns = pool.getWallNs()
+        stats = [{"busy_ns": worker.busyNs,
+                  "tasks": worker.tasks,
+                  "steals": worker.steals,
+                  "utilization": worker.busyNs / wall_ns if wall_ns else 0.0}
+                 for worker in pool.getWorkerStats()]
+        if reset:
+            pool.resetStats()
+        return stats
+
+    def load_map(self, bytes map_data, index=None):
+        """Load a level into the simulation at index, or into all of them."""
+        cdef vector[uchar] cpp_map_data = map_data
+        cdef int cpp_index
+        if index is None:
+            with nogil:
+                self._vec.get().loadMap(cpp_map_data)
+        else:
+            cpp_index = index
+            with nogil:
+                self._vec.get().loadMap(cpp_index, cpp_map_data)
+
+    def reset(self, index=None):
+        cdef int cpp_index
+        if index is None:
+            with nogil:
+                self._vec.get().reset()
+        else:
+            cpp_index = index
+            with nogil:
+                self._vec.get().reset(cpp_index)
+
+    def get_observations(self, float[:, ::1] observations=None):
+        """Observations of every simulation, as a (num_envs, observation_size) float32 array."""
+        if observations is None:
+            observations = np.empty((self.num_envs, self.observation_size), dtype=np.float32)
+        self._check_rows(observations.shape[0], observations.shape[1], self.observation_size, "observations")
+        with nogil:
+            self._vec.get().writeObservations(&observations[0, 0])
+        return np.asarray(observations)
+
+    def step(self, int32_t[:, ::1] actions not None, float[:, ::1] observations=None, float[::1] rewards=None, uint8_t[::1] dones=None):
+        """Tick every simulation with its (horizontal, jump) row of an int32 actions array.
+
+        Writes into the given contiguous observations (float32, num_envs x observation_size),
+        rewards (float32) and dones (uint8) arrays, or new ones, and returns them.
+        """
+        cdef int num_envs = self.num_envs
+        if observations is None:
+            observations = np.empty((num_envs, self.observation_size), dtype=np.float32)
+        if rewards is None:
+            rewards = np.empty(num_envs, dtype=np.float32)
+        if dones is None:
+            dones = np.empty(num_envs, dtype=np.uint8)
+        self._check_rows(actions.shape[0], actions.shape[1], 2, "actions")
+        self._check_rows(observations.shape[0], observations.shape[1], self.observation_size, "observations")
+        self._check_rows(rewards.shape[0], 1, 1, "rewards")
+        self._check_rows(dones.shape[0], 1, 1, "dones")
+
+        with nogil:
+            self._vec.get().step(&actions[0, 0], &observations[0, 0], &rewards[0], &dones[0])
+        return np.asarray(observations), np.asarray(rewards), np.asarray(dones).view(np.bool_)
+
+    def step_async(self, int32_t[:, ::1] actions not None):
+        """Start ticking every simulation on a background thread and return at once.
+
+        The int32 actions are copied, so the array can be reused right away.
+        Call step_wait for the results before using this environment otherwise.
+        """
+        self._check_rows(actions.shape[0], actions.shape[1], 2, "actions")
+        self._vec.get().stepAsync(&actions[0, 0])
+
+    def step_wait(self):
+        """Wait for the step started by step_async and return its observations, rewards and dones.
+
+        The arrays are read-only views of one of two alternating internal buffers,
+        so they can be read while the next step runs. They stay valid until the
+        next step_wait; copy them to keep them longer.
+        """
+        cdef VecStepResult result
+        with nogil:
+            result = self._vec.get().stepWait()
+        cdef np.npy_intp shape[2]
+        shape[0] = self.num_envs
+        shape[1] = self.observation_size
+        return (_buffer_view(self, result.observations, 2, shape, np.NPY_FLOAT32),
+                _buffer_view(self, result.rewards, 1, shape, np.NPY_FLOAT32),
+                _buffer_view(self, result.dones, 1, shape, np.NPY_BOOL))
+
+    def _check_rows(self, Py_ssize_t rows, Py_ssize_t columns, Py_ssize_t expected_columns, str name):
+        if rows != self.num_envs or columns != expected_columns:
+            raise ValueError(f"{name} must have {self.num_envs} rows of {expected_columns} values")
\ No newline at end of file
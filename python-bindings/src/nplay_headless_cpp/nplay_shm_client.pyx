@@ -0,0 +1,142 @@
+# distutils: language = c++
+# distutils: sources = ../src/env_client.cpp ../src/shm_env.cpp
+# distutils: include_dirs = ../src/
+
+# Client of the environment server, which shares memory through POSIX shm_open.
+# setup.py builds this module on Linux only.
+
+from libcpp.vector cimport vector
+from libcpp.memory cimport unique_ptr
+from libcpp.string cimport string
+from libc.stdint cimport int32_t, uint8_t
+from libc.string cimport memcpy
+import numpy as np
+cimport numpy as np
+
+np.import_array()
+
+ctypedef unsigned char uchar
+
+cdef extern from "env_client.hpp" nogil:
+    cdef cppclass EnvClientResult "EnvClient::Result":
+        const float *observations
+        const float *rewards
+        const uint8_t *dones
+
+    cdef cppclass EnvClient:
+        EnvClient(string) except +
+        int size()
+        int getObservationSize()
+        int getRingDepth()
+        int getSlot()
+        int getPending()
+        void loadMap(vector[uchar]&, int) except +
+        EnvClientResult reset(int) except +
+        EnvClientResult step(const int32_t*) except +
+        void stepAsync(const int32_t*) except +
+        EnvClientResult wait() except +
+
+cdef object _buffer_view(object owner, const void *data, int ndim, np.npy_intp *shape, int type_num):
+    """Read-only array over memory that lives as long as owner."""
+    cdef np.ndarray view = np.PyArray_SimpleNewFromData(ndim, shape, type_num, <void*>data)
+    np.set_array_base(view, owner)
+    view.flags.writeable = False
+    return view
+
+cdef class NPlayShmClient:
+    """Client of an environment server (nclone-env-server) hosting the simulations in another process.
+
+    Each client claims one of the server's slots of simulations. Actions and
+    results are exchanged through the server's shared memory in the layout of
+    NPlayVecCpp, so nothing is pickled on the actor hot path.
+    """
+    cdef unique_ptr[EnvClient] _client
+
+    def __cinit__(self, str name="nclone-env"):
+        self._client.reset(new EnvClient(name.encode('utf-8')))
+
+    @property
+    def num_envs(self):
+        return self._client.get().size()
+
+    @property
+    def observation_size(self):
+        return self._client.get().getObservationSize()
+
+    @property
+    def ring_depth(self):
+        """Number of step_async calls that can be in flight."""
+        return self._client.get().getRingDepth()
+
+    @property
+    def slot(self):
+        return self._client.get().getSlot()
+
+    def load_map(self, bytes map_data, index=None):
+        """Load a level into the simulation at index, or into all of them."""
+        cdef vector[uchar] cpp_map_data = map_data
+        cdef int cpp_index = -1 if index is None else index
+        with nogil:
+            self._client.get().loadMap(cpp_map_data, cpp_index)
+
+    def reset(self, index=None):
+        """Reset the simulation at index, or all of them, and return the observations of all of them."""
+        cdef int cpp_index = -1 if index is None else index
+        cdef EnvClientResult result
+        with nogil:
+            result = self._client.get().reset(cpp_index)
+        return self._views(result)[0].copy()
+
+    def step(self, int32_t[:, ::1] actions not None, float[:, ::1] observations=None, float[::1] rewards=None, uint8_t[::1] dones=None):
+        """Tick every simulation with its (horizontal, jump) row of an int32 actions array.
+
+        Copies the results into the given contiguous arrays, or new ones, and returns them, like NPlayVecCpp.step.
+        """
+        cdef int num_envs = self.num_envs
+        cdef int observation_size = self.observation_size
+        if observations is None:
+            observations = np.empty((num_envs, observation_size), dtype=np.float32)
+        if rewards is None:
+            rewards = np.empty(num_envs, dtype=np.float32)
+        if dones is None:
+            dones = np.empty(num_envs, dtype=np.uint8)
+        self._check_rows(actions.shape[0], actions.shape[1], 2, "actions")
+        self._check_rows(observations.shape[0], observations.shape[1], observation_size, "observations")
+        self._check_rows(rewards.shape[0], 1, 1, "rewards")
+        self._check_rows(dones.shape[0], 1, 1, "dones")
+
+        cdef EnvClientResult result
+        with nogil:
+            result = self._client.get().step(&actions[0, 0])
+            memcpy(&observations[0, 0], result.observations, num_envs * observation_size * sizeof(float))
+            memcpy(&rewards[0], result.rewards, num_envs * sizeof(float))
+            memcpy(&dones[0], result.dones, num_envs)
+        return np.asarray(observations), np.asarray(rewards), np.asarray(dones).view(np.bool_)
+
+    def step_async(self, int32_t[:, ::1] actions not None):
+        """Post a step to the server and return at once; up to ring_depth steps can be in flight."""
+        self._check_rows(actions.shape[0], actions.shape[1], 2, "actions")
+        self._client.get().stepAsync(&actions[0, 0])
+
+    def step_wait(self):
+        """Wait for the oldest step posted by step_async and return its observations, rewards and dones.
+
+        The arrays are read-only views of the server's shared memory. They stay
+        valid until ring_depth further requests; copy them to keep them longer.
+        """
+        cdef EnvClientResult result
+        with nogil:
+            result = self._client.get().wait()
+        return self._views(result)
+
+    cdef tuple _views(self, EnvClientResult result):
+        cdef np.npy_intp shape[2]
+        shape[0] = self.num_envs
+        shape[1] = self.observation_size
+        return (_buffer_view(self, result.observations, 2, shape, np.NPY_FLOAT32),
+                _buffer_view(self, result.rewards, 1, shape, np.NPY_FLOAT32),
+                _buffer_view(self, result.dones, 1, shape, np.NPY_BOOL))
+
+    def _check_rows(self, Py_ssize_t rows, Py_ssize_t columns, Py_ssize_t expected_columns, str name):
+        if rows != self.num_envs or columns != expected_columns:
+            raise ValueError(f"{name} must have {self.num_envs} rows of {expected_columns} values")
\ No newline at end of file
@@ -0,0 +1,219 @@
+#include "compiled_map.hpp"
+#include <cmath>
+#include <map>
+#include <mutex>
+
+CompiledMap::CompiledMap(const std::vector<uint8_t> &mapData)
+    : mapData(mapData), clearance(segments)
+{
+  loadTiles();
+}
+
+std::shared_ptr<const CompiledMap> CompiledMap::getShared(const std::vector<uint8_t> &mapData)
+{
+  static std::mutex cacheMutex;
+  static std::map<std::vector<uint8_t>, std::weak_ptr<const CompiledMap>> cache;
+
+  {
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto it = cache.find(mapData);
+    if (it != cache.end())
+    {
+      if (auto map = it->second.lock())
+      {
+        return map;
+      }
+    }
+  }
+
+  // Compile without the lock, so that threads loading different levels do
+  // not wait for each other. Threads compiling the same level at once keep
+  // the instance of the first one to insert it.
+  auto compiled = std::make_shared<const CompiledMap>(mapData);
+
+  std::lock_guard<std::mutex> lock(cacheMutex);
+
+  // Drop levels that no simulation holds anymore
+  for (auto it = cache.begin(); it != cache.end();)
+  {
+    it = it->second.expired() ? cache.erase(it) : std::next(it);
+  }
+
+  auto &entry = cache[mapData];
+  auto map = entry.lock();
+  if (!map)
+  {
+    map = compiled;
+    entry = map;
+  }
+  return map;
+}
+
+void CompiledMap::loadTiles()
+{
+  // Initialize grid edges
+  HalfCellGrid horSegmentDic;
+  HalfCellGrid verSegmentDic;
+  for (int x = 0; x < 89; ++x)
+  {
+    for (int y = 0; y < 51; ++y)
+    {
+      horGridEdgeDic[{x, y}] = (y == 0 || y == 50) ? 1 : 0;
+      verGridEdgeDic[{x, y}] = (x == 0 || x == 88) ? 1 : 0;
+    }
+  }
+
+  // Extract tile data from map data
+  auto tileData = std::vector<uint8_t>(mapData.begin() + 184, mapData.begin() + 1150);
+
+  // Map each tile to its cell
+  for (int x = 0; x < 42; ++x)
+  {
+    for (int y = 0; y < 23; ++y)
+    {
+      tileDic[{x + 1, y + 1}] = tileData[x + y * 42];
+    }
+  }
+
+  // Set outer edges to tile type 1 (full tile)
+  for (int x = 0; x < 44; ++x)
+  {
+    tileDic[{x, 0}] = 1;
+    tileDic[{x, 24}] = 1;
+  }
+  for (int y = 0; y < 25; ++y)
+  {
+    tileDic[{0, y}] = 1;
+    tileDic[{43, y}] = 1;
+  }
+
+  // This loop makes the inventory of grid edges and orthogonal linear segments,
+  // and initiates non-orthogonal linear segments and circular segments.
+  for (int ycoord = 0; ycoord < 25; ++ycoord)
+  {
+    for (int xcoord = 0; xcoord < 44; ++xcoord)
+    {
+      CellCoord coord{xcoord, ycoord};
+      int tileId = tileDic[coord];
+      int xtl = xcoord * 24;
+      int ytl = ycoord * 24;
+
+      if (tileId < 0 || tileId >= TILE_TYPE_COUNT)
+      {
+        continue;
+      }
+
+      // Assign every grid edge and orthogonal linear segment to the dictionaries
+      const auto &gridEdgeList = TILE_GRID_EDGE_MAP[tileId];
+      const auto &segmentOrthoList = TILE_SEGMENT_ORTHO_MAP[tileId];
+
+      // Process horizontal edges and segments
+      for (int y = 0; y < 3; ++y)
+      {
+        for (int x = 0; x < 2; ++x)
+        {
+          CellCoord pos{2 * xcoord + x, 2 * ycoord + y};
+          horGridEdgeDic[pos] = (horGridEdgeDic[pos] + gridEdgeList[2 * y + x]) % 2;
+          horSegmentDic[pos] += segmentOrthoList[2 * y + x];
+        }
+      }
+
+      // Process vertical edges and segments
+      for (int x = 0; x < 3; ++x)
+      {
+        for (int y = 0; y < 2; ++y)
+        {
+          CellCoord pos{2 * xcoord + x, 2 * ycoord + y};
+          verGridEdgeDic[pos] = (verGridEdgeDic[pos] + gridEdgeList[2 * x + y + 6]) % 2;
+          verSegmentDic[pos] += segmentOrthoList[2 * x + y + 6];
+        }
+      }
+
+      // Initiate non-orthogonal linear and circular segments. A diagonal is
+      // staged before the cell's orthogonal segments, so it comes first in its
+      // cell's range, which the tile kernels rely on.
+      const TileDiagonal &diagonal = TILE_SEGMENT_DIAG_MAP[tileId];
+      if (diagonal.present)
+      {
+        segments.addLinear(coord, GridSegmentLinear(
+                                    std::make_pair(xtl + diagonal.x1, ytl + diagonal.y1),
+                                    std::make_pair(xtl + diagonal.x2, ytl + diagonal.y2)));
+      }
+
+      const TileArc &arc = TILE_SEGMENT_CIRCULAR_MAP[tileId];
+      if (arc.present)
+      {
+        segments.addCircular(coord, GridSegmentCircular(
+                                        std::make_pair(xtl + arc.xcenter, ytl + arc.ycenter),
+                                        std::make_pair(arc.hor, arc.ver), arc.convex));
+      }
+    }
+  }
+
+  // Initiate segments from the dictionaries of orthogonal linear segments.
+  // Note that two segments of the same position but opposite orientation cancel each other,
+  // and no segment is initiated.
+  //
+  // Both dictionaries are walked in row-major order. Closest point queries
+  // keep the first of equally close segments, so this order breaks their
+  // ties; the hash maps this replaced visited the segments in an order that
+  // depended on the standard library and on earlier loads, so trajectories
+  // through such ties can differ from theirs. tests/segment_order_test.cpp
+  // pins the order.
+  for (int ycoord = 0; ycoord < 51; ++ycoord)
+  {
+    for (int xcoord = 0; xcoord < 89; ++xcoord)
+    {
+      int state = horSegmentDic[{xcoord, ycoord}];
+      if (state)
+      {
+        CellCoord cell{static_cast<int>(std::floor(xcoord / 2)),
+                       static_cast<int>(std::floor((ycoord - Real(0.1) * state) / 2))};
+
+        std::pair<Real, Real> point1{12 * xcoord, 12 * ycoord};
+        std::pair<Real, Real> point2{12 * xcoord + 12, 12 * ycoord};
+
+        if (state == -1)
+        {
+          std::swap(point1, point2);
+        }
+
+        segments.addLinear(cell, GridSegmentLinear(point1, point2));
+      }
+    }
+  }
+
+  for (int ycoord = 0; ycoord < 51; ++ycoord)
+  {
+    for (int xcoord = 0; xcoord < 89; ++xcoord)
+    {
+      int state = verSegmentDic[{xcoord, ycoord}];
+      if (state)
+      {
+        CellCoord cell{static_cast<int>(std::floor((xcoord - Real(0.1) * state) / 2)),
+                       static_cast<int>(std::floor(ycoord / 2))};
+
+        std::pair<Real, Real> point1{12 * xcoord, 12 * ycoord + 12};
+        std::pair<Real, Real> point2{12 * xcoord, 12 * ycoord};
+
+        if (state == -1)
+        {
+          std::swap(point1, point2);
+        }
+
+        segments.addLinear(cell, GridSegmentLinear(point1, point2));
+      }
+    }
+  }
+
+  segments.build();
+
+  for (int x = 0; x < 89; ++x)
+  {
+    for (int y = 0; y < 51; ++y)
+    {
+      horEdgeBits.set(y, x, horGridEdgeDic[{x, y}] != 0);
+      verEdgeBits.set(x, y, verGridEdgeDic[{x, y}] != 0);
+    }
+  }
+}
\ No newline at end of file
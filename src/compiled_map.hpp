@@ -0,0 +1,220 @@
+#pragma once
+
+#include "physics/segment_store.hpp"
+#include "physics/clearance_field.hpp"
+#include "utils.hpp"
+
+#include <vector>
+#include <memory>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+
+// Tile types grouped by the segments they contribute besides orthogonal ones:
+// none, a diagonal linear or a quarter circle
+enum class TileShape : uint8_t
+{
+  Empty,
+  Full,
+  Half,
+  Slope,
+  QuarterMoon,
+  QuarterPipe,
+  Glitched
+};
+
+// The static part of a level: tiles, tile segments and the grid edges they
+// produce. It never changes once built, so any number of simulations playing
+// the same level can share one instance. Doors and everything else that can
+// change during an episode live in each Simulation.
+class CompiledMap
+{
+public:
+  using CellCoord = std::pair<int, int>;
+  using HalfCellGrid = Grid<int, 89, 51>;
+  // Grid edges as bits, horizontal ones along rows and vertical ones along columns
+  using HorEdgeBits = Bitboard<51, 89>;
+  using VerEdgeBits = Bitboard<89, 51>;
+
+  // Tile geometry, indexed by tile id. Ids outside [0, TILE_TYPE_COUNT) have none.
+  static constexpr int TILE_TYPE_COUNT = 38;
+
+  // Non-orthogonal segment of a tile, as offsets from its top left corner.
+  // Tiles without one have an all zero entry.
+  struct TileDiagonal
+  {
+    bool present;
+    int x1, y1, x2, y2;
+  };
+  struct TileArc
+  {
+    bool present;
+    int xcenter, ycenter;
+    int hor, ver; // Quadrant
+    bool convex;
+  };
+
+  static constexpr std::array<std::array<int8_t, 12>, TILE_TYPE_COUNT> TILE_GRID_EDGE_MAP = {{
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, // Empty tile
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}, // Full tile
+      {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0}, // Half tiles
+      {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1},
+      {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1},
+      {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0},
+      {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0}, // 45 degree slopes
+      {1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1},
+      {0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1},
+      {1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}, // Quarter moons
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0}, // Quarter pipes
+      {1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1},
+      {0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1},
+      {1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1},
+      {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0}, // Short mild slopes
+      {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0},
+      {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1},
+      {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}, // Raised mild slopes
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0}, // Short steep slopes
+      {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1},
+      {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1},
+      {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}, // Raised steep slopes
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1},
+      {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, // Glitched tiles
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0}
+  }};
+
+  static constexpr std::array<std::array<int8_t, 12>, TILE_TYPE_COUNT> TILE_SEGMENT_ORTHO_MAP = {{
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},     // Empty tile
+      {-1, -1, 0, 0, 1, 1, -1, -1, 0, 0, 1, 1}, // Full tile
+      {-1, -1, 1, 1, 0, 0, -1, 0, 0, 0, 1, 0},  // Half tiles
+      {0, -1, 0, 0, 0, 1, 0, 0, -1, -1, 1, 1},
+      {0, 0, -1, -1, 1, 1, 0, -1, 0, 0, 0, 1},
+      {-1, 0, 0, 0, 1, 0, -1, -1, 1, 1, 0, 0},
+      {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}, // 45 degree slopes
+      {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}, // Quarter moons
+      {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}, // Quarter pipes
+      {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0},  // Short mild slopes
+      {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1},
+      {0, 0, 0, 0, 1, 1, 0, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 1, 0}, // Raised mild slopes
+      {-1, -1, 0, 0, 0, 0, -1, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, -1, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 1},
+      {-1, 0, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0},  // Short steep slopes
+      {0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 0, -1, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 1, 0, -1, -1, 0, 0, 0, 0}, // Raised steep slopes
+      {-1, -1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1},
+      {0, -1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1},
+      {-1, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0},
+      {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0},   // Glitched tiles
+      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1},
+      {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0},
+      {0, 0, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}
+  }};
+
+  static constexpr std::array<TileDiagonal, TILE_TYPE_COUNT> TILE_SEGMENT_DIAG_MAP = {{
+      {}, {}, {}, {}, {}, {},       // Empty, full and half tiles
+      {true, 0, 24, 24, 0},         // 45 degree slopes
+      {true, 0, 0, 24, 24},
+      {true, 24, 0, 0, 24},
+      {true, 24, 24, 0, 0},
+      {}, {}, {}, {}, {}, {}, {}, {}, // Quarter moons and pipes
+      {true, 0, 12, 24, 0},         // Short mild slopes
+      {true, 0, 0, 24, 12},
+      {true, 24, 12, 0, 24},
+      {true, 24, 24, 0, 12},
+      {true, 0, 24, 24, 12},        // Raised mild slopes
+      {true, 0, 12, 24, 24},
+      {true, 24, 0, 0, 12},
+      {true, 24, 12, 0, 0},
+      {true, 0, 24, 12, 0},         // Short steep slopes
+      {true, 12, 0, 24, 24},
+      {true, 24, 0, 12, 24},
+      {true, 12, 24, 0, 0},
+      {true, 12, 24, 24, 0},        // Raised steep slopes
+      {true, 0, 0, 12, 24},
+      {true, 12, 0, 0, 24},
+      {true, 24, 24, 12, 0},
+      {}, {}, {}, {}              // Glitched tiles
+  }};
+
+  static constexpr std::array<TileArc, TILE_TYPE_COUNT> TILE_SEGMENT_CIRCULAR_MAP = {{
+      {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, // Empty, full and half tiles, 45 degree slopes
+      {true, 0, 0, 1, 1, true},       // Quarter moons
+      {true, 24, 0, -1, 1, true},
+      {true, 24, 24, -1, -1, true},
+      {true, 0, 24, 1, -1, true},
+      {true, 24, 24, -1, -1, false},  // Quarter pipes
+      {true, 0, 24, 1, -1, false},
+      {true, 0, 0, 1, 1, false},
+      {true, 24, 0, -1, 1, false},
+      {}, {}, {}, {}, {}, {}, {}, {}, {}, {}, // Mild and steep slopes, glitched tiles
+      {}, {}, {}, {}, {}, {}, {}, {}, {}, {}
+  }};
+
+  static constexpr std::array<TileShape, TILE_TYPE_COUNT> TILE_SHAPES = {{
+      TileShape::Empty,
+      TileShape::Full,
+      TileShape::Half, TileShape::Half, TileShape::Half, TileShape::Half,
+      TileShape::Slope, TileShape::Slope, TileShape::Slope, TileShape::Slope,
+      TileShape::QuarterMoon, TileShape::QuarterMoon, TileShape::QuarterMoon, TileShape::QuarterMoon,
+      TileShape::QuarterPipe, TileShape::QuarterPipe, TileShape::QuarterPipe, TileShape::QuarterPipe,
+      TileShape::Slope, TileShape::Slope, TileShape::Slope, TileShape::Slope,
+      TileShape::Slope, TileShape::Slope, TileShape::Slope, TileShape::Slope,
+      TileShape::Slope, TileShape::Slope, TileShape::Slope, TileShape::Slope,
+      TileShape::Slope, TileShape::Slope, TileShape::Slope, TileShape::Slope,
+      TileShape::Glitched, TileShape::Glitched, TileShape::Glitched, TileShape::Glitched
+  }};
+
+  explicit CompiledMap(const std::vector<uint8_t> &mapData);
+
+  // Return the compiled map for this map data, reusing the instance of any
+  // simulation that still holds the same level
+  static std::shared_ptr<const CompiledMap> getShared(const std::vector<uint8_t> &mapData);
+
+  const std::vector<uint8_t> &getMapData() const { return mapData; }
+  const TileDictionary &getTileDic() const { return tileDic; }
+  const SegmentStore &getSegments() const { return segments; }
+  const ClearanceField &getClearance() const { return clearance; }
+  int getHorGridEdge(const CellCoord &cell) const { return horGridEdgeDic[cell]; }
+  int getVerGridEdge(const CellCoord &cell) const { return verGridEdgeDic[cell]; }
+  const HorEdgeBits &getHorEdgeBits() const { return horEdgeBits; }
+  const VerEdgeBits &getVerEdgeBits() const { return verEdgeBits; }
+
+private:
+  void loadTiles();
+
+  std::vector<uint8_t> mapData;
+  TileDictionary tileDic;
+  SegmentStore segments;
+  ClearanceField clearance;
+  HalfCellGrid horGridEdgeDic;
+  HalfCellGrid verGridEdgeDic;
+  HorEdgeBits horEdgeBits;
+  VerEdgeBits verEdgeBits;
+};
\ No newline at end of file
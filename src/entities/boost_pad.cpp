@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-BoostPad::BoostPad(Simulation *sim, float xcoord, float ycoord)
+BoostPad::BoostPad(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
   isTouchingNinja = false;
@@ -24,11 +24,11 @@ void BoostPad::move()
   {
     if (!isTouchingNinja)
     {
-      float velNorm = std::sqrt(ninja->xspeed * ninja->xspeed + ninja->yspeed * ninja->yspeed);
+      Real velNorm = std::sqrt(ninja->xspeed * ninja->xspeed + ninja->yspeed * ninja->yspeed);
       if (velNorm > 0)
       {
-        float xBoost = 2.0f * ninja->xspeed / velNorm;
-        float yBoost = 2.0f * ninja->yspeed / velNorm;
+        Real xBoost = Real(2.0) * ninja->xspeed / velNorm;
+        Real yBoost = Real(2.0) * ninja->yspeed / velNorm;
         ninja->xspeed += xBoost;
         ninja->yspeed += yBoost;
       }
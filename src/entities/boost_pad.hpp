@@ -7,10 +7,10 @@ class BoostPad : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 24;
-  static constexpr float RADIUS = 6.0f;
+  static constexpr Real RADIUS = 6.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 128;
 
-  BoostPad(Simulation *sim, float xcoord, float ycoord);
+  BoostPad(Simulation *sim, Real xcoord, Real ycoord);
 
   void move() override;
   bool isMovable() const override { return true; }
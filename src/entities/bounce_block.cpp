@@ -2,7 +2,7 @@
 #include "../physics/physics.hpp"
 #include "../ninja.hpp"
 
-BounceBlock::BounceBlock(Simulation *sim, float xcoord, float ycoord)
+BounceBlock::BounceBlock(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
   logPositions = sim->getConfig().fullExport;
@@ -21,8 +21,8 @@ void BounceBlock::move()
   ypos += yspeed;
 
   // Apply spring force
-  float xforce = STIFFNESS * (xorigin - xpos);
-  float yforce = STIFFNESS * (yorigin - ypos);
+  Real xforce = STIFFNESS * (xorigin - xpos);
+  Real yforce = STIFFNESS * (yorigin - ypos);
   xpos += xforce;
   ypos += yforce;
   xspeed += xforce;
@@ -43,10 +43,10 @@ std::optional<EntityCollisionResult> BounceBlock::physicalCollision()
   const auto &[depenLen, depenLen2] = penetrations;
 
   // Apply 80% of depenetration to block, 20% to ninja
-  xpos -= depenX * depenLen * (1.0f - STRENGTH);
-  ypos -= depenY * depenLen * (1.0f - STRENGTH);
-  xspeed -= depenX * depenLen * (1.0f - STRENGTH);
-  yspeed -= depenY * depenLen * (1.0f - STRENGTH);
+  xpos -= depenX * depenLen * (Real(1.0) - STRENGTH);
+  ypos -= depenY * depenLen * (Real(1.0) - STRENGTH);
+  xspeed -= depenX * depenLen * (Real(1.0) - STRENGTH);
+  yspeed -= depenY * depenLen * (Real(1.0) - STRENGTH);
 
   return EntityCollisionResult(
       depenX,
@@ -58,7 +58,7 @@ std::optional<EntityCollisionResult> BounceBlock::physicalCollision()
 std::optional<EntityCollisionResult> BounceBlock::logicalCollision()
 {
   auto ninja = sim->getNinja();
-  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + ninja->RADIUS + 0.1f);
+  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + ninja->RADIUS + Real(0.1));
   if (!depen)
     return std::nullopt;
 
@@ -8,13 +8,13 @@ class BounceBlock : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 17;
-  static constexpr float SEMI_SIDE = 9.0f;
-  static constexpr float STIFFNESS = 0.02222222222222222f;
-  static constexpr float DAMPENING = 0.98f;
-  static constexpr float STRENGTH = 0.2f;
+  static constexpr Real SEMI_SIDE = 9.0;
+  static constexpr Real STIFFNESS = 0.02222222222222222;
+  static constexpr Real DAMPENING = 0.98;
+  static constexpr Real STRENGTH = 0.2;
   static constexpr int MAX_COUNT_PER_LEVEL = 512;
 
-  BounceBlock(Simulation *sim, float xcoord, float ycoord);
+  BounceBlock(Simulation *sim, Real xcoord, Real ycoord);
 
   void move() override;
   std::optional<EntityCollisionResult> physicalCollision() override;
@@ -24,6 +24,6 @@ public:
   bool isMovable() const override { return true; }
 
 private:
-  float xorigin;
-  float yorigin;
+  Real xorigin;
+  Real yorigin;
 };
\ No newline at end of file
@@ -4,7 +4,7 @@
 #include "../physics/physics.hpp"
 #include <cmath>
 
-DeathBall::DeathBall(Simulation *sim, float xcoord, float ycoord)
+DeathBall::DeathBall(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
 }
@@ -21,9 +21,9 @@ void DeathBall::think()
   else
   {
     // Apply acceleration towards closest ninja
-    float dx = ninja->getXPos() - xpos;
-    float dy = ninja->getYPos() - ypos;
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = ninja->getXPos() - xpos;
+    Real dy = ninja->getYPos() - ypos;
+    Real dist = std::sqrt(dx * dx + dy * dy);
     if (dist > 0)
     {
       dx /= dist;
@@ -33,11 +33,11 @@ void DeathBall::think()
     yspeed += dy * ACCELERATION;
 
     // Apply drag if speed exceeds MAX_SPEED
-    float speed = std::sqrt(xspeed * xspeed + yspeed * yspeed);
+    Real speed = std::sqrt(xspeed * xspeed + yspeed * yspeed);
     if (speed > MAX_SPEED)
     {
-      float newSpeed = (speed - MAX_SPEED) * DRAG_MAX_SPEED;
-      if (newSpeed <= 0.01f)
+      Real newSpeed = (speed - MAX_SPEED) * DRAG_MAX_SPEED;
+      if (newSpeed <= Real(0.01))
       {
         newSpeed = 0;
       }
@@ -47,38 +47,40 @@ void DeathBall::think()
     }
   }
 
-  float xposOld = xpos;
-  float yposOld = ypos;
+  Real xposOld = xpos;
+  Real yposOld = ypos;
   xpos += xspeed;
   ypos += yspeed;
 
   // Interpolation routine for high-speed wall collisions
-  float time = Physics::sweepCircleVsTiles(*sim, xposOld, yposOld, xspeed, yspeed, RADIUS2 * 0.5f);
+  Real time = Physics::sweepCircleVsTiles(*sim, xposOld, yposOld, xspeed, yspeed, RADIUS2 * Real(0.5));
   xpos = xposOld + time * xspeed;
   ypos = yposOld + time * yspeed;
 
-  // Depenetration routine for collision against tiles
-  float xnormal = 0, ynormal = 0;
-  for (int i = 0; i < 16; i++)
+  // Depenetration routine for collision against tiles.
+  // Skipped in open air, where no segment is close enough to push the ball
+  Real xnormal = 0, ynormal = 0;
+  int iterations = Physics::isClearOfTiles(*sim, xpos, ypos, RADIUS2) ? 0 : 16;
+  for (int i = 0; i < iterations; i++)
   {
     auto result = Physics::getSingleClosestPoint(*sim, xpos, ypos, RADIUS2);
     if (!result)
       break;
 
     auto [isBackFacing, closestPoint] = *result;
-    float dx = xpos - closestPoint.first;
-    float dy = ypos - closestPoint.second;
-    float dist = std::sqrt(dx * dx + dy * dy);
-    float depenLen = RADIUS2 - dist * (isBackFacing ? -1.0f : 1.0f);
+    Real dx = xpos - closestPoint.first;
+    Real dy = ypos - closestPoint.second;
+    Real dist = std::sqrt(dx * dx + dy * dy);
+    Real depenLen = RADIUS2 - dist * (isBackFacing ? Real(-1.0) : Real(1.0));
 
-    if (depenLen < 0.0000001f)
+    if (depenLen < Real(0.0000001))
       break;
 
     if (dist == 0)
       return;
 
-    float xnorm = dx / dist;
-    float ynorm = dy / dist;
+    Real xnorm = dx / dist;
+    Real ynorm = dy / dist;
     xpos += xnorm * depenLen;
     ypos += ynorm * depenLen;
     xnormal += xnorm;
@@ -86,16 +88,16 @@ void DeathBall::think()
   }
 
   // If there has been tile collision, project speed onto surface and add bounce if applicable
-  float normalLen = std::sqrt(xnormal * xnormal + ynormal * ynormal);
+  Real normalLen = std::sqrt(xnormal * xnormal + ynormal * ynormal);
   if (normalLen > 0)
   {
-    float dx = xnormal / normalLen;
-    float dy = ynormal / normalLen;
-    float dotProduct = xspeed * dx + yspeed * dy;
+    Real dx = xnormal / normalLen;
+    Real dy = ynormal / normalLen;
+    Real dotProduct = xspeed * dx + yspeed * dy;
     if (dotProduct < 0)
     {
-      float speed = std::sqrt(xspeed * xspeed + yspeed * yspeed);
-      float bounceStrength = speed <= 1.35f ? 1.0f : 2.0f;
+      Real speed = std::sqrt(xspeed * xspeed + yspeed * yspeed);
+      Real bounceStrength = speed <= Real(1.35) ? Real(1.0) : Real(2.0);
       xspeed -= dx * dotProduct * bounceStrength;
       yspeed -= dy * dotProduct * bounceStrength;
     }
@@ -108,7 +110,7 @@ void DeathBall::think()
   size_t myIndex = 0;
   for (; myIndex < deathBalls.size(); myIndex++)
   {
-    if (deathBalls[myIndex].get() == this)
+    if (deathBalls[myIndex] == this)
     {
       break;
     }
@@ -118,13 +120,12 @@ void DeathBall::think()
   // to avoid processing each collision twice
   for (size_t i = myIndex + 1; i < deathBalls.size(); i++)
   {
-    auto otherBall = dynamic_cast<DeathBall *>(deathBalls[i].get());
-    if (!otherBall)
-      continue;
+    // Every entity in this list has our type, so the downcast is always valid
+    auto otherBall = static_cast<DeathBall *>(deathBalls[i]);
 
-    float dx = xpos - otherBall->getXPos();
-    float dy = ypos - otherBall->getYPos();
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = xpos - otherBall->getXPos();
+    Real dy = ypos - otherBall->getYPos();
+    Real dist = std::sqrt(dx * dx + dy * dy);
     if (dist < 16)
     {
       dx = dx / dist * 4;
@@ -149,13 +150,13 @@ std::optional<EntityCollisionResult> DeathBall::logicalCollision()
           xpos, ypos, RADIUS,
           ninja->getXPos(), ninja->getYPos(), ninja->RADIUS))
   {
-    float dx = xpos - ninja->getXPos();
-    float dy = ypos - ninja->getYPos();
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = xpos - ninja->getXPos();
+    Real dy = ypos - ninja->getYPos();
+    Real dist = std::sqrt(dx * dx + dy * dy);
     xspeed += dx / dist * 10;
     yspeed += dy / dist * 10;
     ninja->kill(0, 0, 0, 0, 0);
-    return std::optional<EntityCollisionResult>(EntityCollisionResult(1.0f));
+    return std::optional<EntityCollisionResult>(EntityCollisionResult(Real(1.0)));
   }
   return std::nullopt;
 }
\ No newline at end of file
@@ -4,8 +4,8 @@
 #include "../physics/grid_segment_linear.hpp"
 #include <cmath>
 
-DoorBase::DoorBase(int entityType, Simulation *sim, float xcoord, float ycoord,
-                   int orientation, float swXcoord, float swYcoord)
+DoorBase::DoorBase(int entityType, Simulation *sim, Real xcoord, Real ycoord,
+                   int orientation, Real swXcoord, Real swYcoord)
     : Entity(entityType, sim, xcoord, ycoord),
       orientation(orientation),
       swXcoord(swXcoord * 6), // Convert to internal coordinates
@@ -27,13 +27,14 @@ DoorBase::DoorBase(int entityType, Simulation *sim, float xcoord, float ycoord,
   int doorHalfYcell = 2 * (doorCell.second + 1);
 
   // Create the grid segment and grid edges
+  auto &segments = sim->getDoorSegments();
   if (isVertical)
   {
-    segment = std::make_shared<GridSegmentLinear>(
-        std::make_pair(xpos, ypos - 12),
-        std::make_pair(xpos, ypos + 12),
-        false // not oriented
-    );
+    segmentId = segments.addDoor(doorCell, GridSegmentLinear(
+                                               std::make_pair(xpos, ypos - 12),
+                                               std::make_pair(xpos, ypos + 12),
+                                               false // not oriented
+                                               ));
     gridEdges.push_back(std::make_pair(doorHalfXcell, doorHalfYcell - 2));
     gridEdges.push_back(std::make_pair(doorHalfXcell, doorHalfYcell - 1));
     for (const auto &edge : gridEdges)
@@ -43,11 +44,11 @@ DoorBase::DoorBase(int entityType, Simulation *sim, float xcoord, float ycoord,
   }
   else
   {
-    segment = std::make_shared<GridSegmentLinear>(
-        std::make_pair(xpos - 12, ypos),
-        std::make_pair(xpos + 12, ypos),
-        false // not oriented
-    );
+    segmentId = segments.addDoor(doorCell, GridSegmentLinear(
+                                               std::make_pair(xpos - 12, ypos),
+                                               std::make_pair(xpos + 12, ypos),
+                                               false // not oriented
+                                               ));
     gridEdges.push_back(std::make_pair(doorHalfXcell - 2, doorHalfYcell));
     gridEdges.push_back(std::make_pair(doorHalfXcell - 1, doorHalfYcell));
     for (const auto &edge : gridEdges)
@@ -56,8 +57,6 @@ DoorBase::DoorBase(int entityType, Simulation *sim, float xcoord, float ycoord,
     }
   }
 
-  sim->getSegmentsAt(doorCell).push_back(segment);
-
   // Update position and cell so it corresponds to the switch and not the door
   xpos = swXcoord;
   ypos = swYcoord;
@@ -69,7 +68,7 @@ void DoorBase::changeState(bool newClosed)
   if (closed != newClosed)
   {
     closed = newClosed;
-    segment->setActive(closed);
+    sim->getDoorSegments().setDoorActive(segmentId, closed);
     logCollision(closed ? 0 : 1);
 
     for (const auto &edge : gridEdges)
@@ -86,15 +85,49 @@ void DoorBase::changeState(bool newClosed)
   }
 }
 
-std::vector<float> DoorBase::getState(bool minimalState) const
+void DoorBase::clearGridEdges()
+{
+  for (const auto &edge : gridEdges)
+  {
+    if (isVertical)
+    {
+      sim->setVerGridEdge(edge, 0);
+    }
+    else
+    {
+      sim->setHorGridEdge(edge, 0);
+    }
+  }
+}
+
+void DoorBase::applyGridState()
+{
+  sim->getDoorSegments().setDoorActive(segmentId, closed);
+  if (!closed)
+    return;
+
+  for (const auto &edge : gridEdges)
+  {
+    if (isVertical)
+    {
+      sim->incrementVerGridEdge(edge, 1);
+    }
+    else
+    {
+      sim->incrementHorGridEdge(edge, 1);
+    }
+  }
+}
+
+std::vector<Real> DoorBase::getState(bool minimalState) const
 {
   auto baseState = Entity::getState(minimalState);
   if (!minimalState)
   {
-    baseState.push_back(static_cast<float>(orientation));
+    baseState.push_back(static_cast<Real>(orientation));
     baseState.push_back(swXcoord);
     baseState.push_back(swYcoord);
-    baseState.push_back(closed ? 1.0f : 0.0f);
+    baseState.push_back(closed ? Real(1.0) : Real(0.0));
   }
   return baseState;
 }
\ No newline at end of file
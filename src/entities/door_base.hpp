@@ -1,26 +1,31 @@
 #pragma once
 
 #include "entity.hpp"
-#include "../physics/segment.hpp"
-#include <memory>
+#include <cstddef>
 #include <vector>
 #include <utility>
 
 class DoorBase : public Entity
 {
 public:
-  DoorBase(int type, Simulation *sim, float xcoord, float ycoord, int orientation, float swXcoord, float swYcoord);
+  DoorBase(int type, Simulation *sim, Real xcoord, Real ycoord, int orientation, Real swXcoord, Real swYcoord);
 
   bool isLogicalCollidable() const override { return true; }
-  std::vector<float> getState(bool minimalState = false) const override;
+  std::vector<Real> getState(bool minimalState = false) const override;
+
+  // Re-derive the door segment and grid edges from the door state after a
+  // simulation restore. Every door's edges are cleared before any is applied,
+  // since neighbouring doors can share an edge.
+  void clearGridEdges();
+  void applyGridState();
 
 protected:
   void changeState(bool closed);
   bool closed = true;
   int orientation;
-  float swXcoord;
-  float swYcoord;
+  Real swXcoord;
+  Real swYcoord;
   bool isVertical;
-  std::shared_ptr<Segment> segment;
+  std::size_t segmentId; // Door id in the simulation's segment store
   std::vector<std::pair<int, int>> gridEdges;
 };
\ No newline at end of file
@@ -2,8 +2,8 @@
 #include "../simulation.hpp"
 #include "../ninja.hpp"
 
-DoorLocked::DoorLocked(Simulation *sim, float xcoord, float ycoord,
-                       int orientation, float swXcoord, float swYcoord)
+DoorLocked::DoorLocked(Simulation *sim, Real xcoord, Real ycoord,
+                       int orientation, Real swXcoord, Real swYcoord)
     : DoorBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, swXcoord, swYcoord)
 {
 }
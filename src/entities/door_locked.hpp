@@ -6,11 +6,11 @@ class DoorLocked : public DoorBase
 {
 public:
   static constexpr int ENTITY_TYPE = 6;
-  static constexpr float RADIUS = 5.0f;
+  static constexpr Real RADIUS = 5.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 256;
 
-  DoorLocked(Simulation *sim, float xcoord, float ycoord,
-             int orientation, float swXcoord, float swYcoord);
+  DoorLocked(Simulation *sim, Real xcoord, Real ycoord,
+             int orientation, Real swXcoord, Real swYcoord);
 
   std::optional<EntityCollisionResult> logicalCollision() override;
 };
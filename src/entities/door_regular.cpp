@@ -2,8 +2,8 @@
 #include "../simulation.hpp"
 #include "../ninja.hpp"
 
-DoorRegular::DoorRegular(Simulation *sim, float xcoord, float ycoord,
-                         int orientation, float swXcoord, float swYcoord)
+DoorRegular::DoorRegular(Simulation *sim, Real xcoord, Real ycoord,
+                         int orientation, Real swXcoord, Real swYcoord)
     : DoorBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, swXcoord, swYcoord)
 {
 }
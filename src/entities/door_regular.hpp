@@ -6,11 +6,11 @@ class DoorRegular : public DoorBase
 {
 public:
   static constexpr int ENTITY_TYPE = 5;
-  static constexpr float RADIUS = 10.0f;
+  static constexpr Real RADIUS = 10.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 256;
 
-  DoorRegular(Simulation *sim, float xcoord, float ycoord,
-              int orientation, float swXcoord, float swYcoord);
+  DoorRegular(Simulation *sim, Real xcoord, Real ycoord,
+              int orientation, Real swXcoord, Real swYcoord);
 
   void think() override;
   std::optional<EntityCollisionResult> logicalCollision() override;
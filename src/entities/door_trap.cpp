@@ -2,8 +2,8 @@
 #include "../simulation.hpp"
 #include "../ninja.hpp"
 
-DoorTrap::DoorTrap(Simulation *sim, float xcoord, float ycoord,
-                   int orientation, float swXcoord, float swYcoord)
+DoorTrap::DoorTrap(Simulation *sim, Real xcoord, Real ycoord,
+                   int orientation, Real swXcoord, Real swYcoord)
     : DoorBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, swXcoord, swYcoord)
 {
 }
@@ -14,7 +14,7 @@ std::optional<EntityCollisionResult> DoorTrap::logicalCollision()
           swXcoord, swYcoord, RADIUS,
           sim->getNinja()->xpos, sim->getNinja()->ypos, sim->getNinja()->RADIUS))
   {
-    active = false;
+    setActive(false);
     changeState(true);
   }
   return std::nullopt;
@@ -2,11 +2,11 @@
 #include "../physics/physics.hpp"
 
 // Initialize static members
-const std::unordered_map<int, std::array<float, 2>> DroneBase::DIR_TO_VEC = {
-    {0, {1.0f, 0.0f}},
-    {1, {0.0f, 1.0f}},
-    {2, {-1.0f, 0.0f}},
-    {3, {0.0f, -1.0f}}};
+const std::unordered_map<int, std::array<Real, 2>> DroneBase::DIR_TO_VEC = {
+    {0, {Real(1.0), Real(0.0)}},
+    {1, {Real(0.0), Real(1.0)}},
+    {2, {Real(-1.0), Real(0.0)}},
+    {3, {Real(0.0), Real(-1.0)}}};
 
 // Dictionary to choose the next direction from the patrolling mode of the drone.
 // Patrolling modes : {0:follow wall CW, 1:follow wall CCW, 2:wander CW, 3:wander CCW}
@@ -17,7 +17,7 @@ const std::unordered_map<int, std::array<int, 4>> DroneBase::DIR_LIST = {
     {2, {0, 1, 3, 2}},
     {3, {0, 3, 1, 2}}};
 
-DroneBase::DroneBase(int entityType, Simulation *sim, float xcoord, float ycoord, int orientation, int mode, float speed)
+DroneBase::DroneBase(int entityType, Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode, Real speed)
     : Entity(entityType, sim, xcoord, ycoord),
       orientation(orientation),
       mode(mode),
@@ -43,21 +43,21 @@ void DroneBase::turn(int newDir)
 void DroneBase::move()
 {
   auto [dirX, dirY] = DIR_TO_VEC.at(dir);
-  float xspeed = speed * dirX;
-  float yspeed = speed * dirY;
-  float dx = goalX - xpos;
-  float dy = goalY - ypos;
-  float dist = std::sqrt(dx * dx + dy * dy);
+  Real xspeed = speed * dirX;
+  Real yspeed = speed * dirY;
+  Real dx = goalX - xpos;
+  Real dy = goalY - ypos;
+  Real dist = std::sqrt(dx * dx + dy * dy);
 
   // If the drone has reached or passed the center of the cell, choose the next cell to go to
-  if (dist < 0.000001f || (dx * (goalX - (xpos + xspeed)) + dy * (goalY - (ypos + yspeed))) < 0)
+  if (dist < Real(0.000001) || (dx * (goalX - (xpos + xspeed)) + dy * (goalY - (ypos + yspeed))) < 0)
   {
     xpos = goalX;
     ypos = goalY;
     bool canMove = chooseNextDirectionAndGoal();
     if (canMove)
     {
-      float disp = speed - dist;
+      Real disp = speed - dist;
       auto [newDirX, newDirY] = DIR_TO_VEC.at(dir);
       xpos += disp * newDirX;
       ypos += disp * newDirY;
@@ -74,15 +74,15 @@ void DroneBase::move()
 bool DroneBase::testNextDirectionAndGoal(int dir)
 {
   auto [dirX, dirY] = DIR_TO_VEC.at(dir);
-  float nextGoalX = xpos + GRID_WIDTH * dirX;
-  float nextGoalY = ypos + GRID_WIDTH * dirY;
+  Real nextGoalX = xpos + GRID_WIDTH * dirX;
+  Real nextGoalY = ypos + GRID_WIDTH * dirY;
 
   if (dirY == 0)
   {
-    int cellX = static_cast<int>(std::floor((xpos + dirX * RADIUS) / 12.0f));
-    int cellXTarget = static_cast<int>(std::floor((nextGoalX + dirX * RADIUS) / 12.0f));
-    int cellY1 = static_cast<int>(std::floor((ypos - RADIUS) / 12.0f));
-    int cellY2 = static_cast<int>(std::floor((ypos + RADIUS) / 12.0f));
+    int cellX = static_cast<int>(std::floor((xpos + dirX * RADIUS) / Real(12.0)));
+    int cellXTarget = static_cast<int>(std::floor((nextGoalX + dirX * RADIUS) / Real(12.0)));
+    int cellY1 = static_cast<int>(std::floor((ypos - RADIUS) / Real(12.0)));
+    int cellY2 = static_cast<int>(std::floor((ypos + RADIUS) / Real(12.0)));
 
     while (cellX != cellXTarget)
     {
@@ -95,10 +95,10 @@ bool DroneBase::testNextDirectionAndGoal(int dir)
   }
   else
   {
-    int cellY = static_cast<int>(std::floor((ypos + dirY * RADIUS) / 12.0f));
-    int cellYTarget = static_cast<int>(std::floor((nextGoalY + dirY * RADIUS) / 12.0f));
-    int cellX1 = static_cast<int>(std::floor((xpos - RADIUS) / 12.0f));
-    int cellX2 = static_cast<int>(std::floor((xpos + RADIUS) / 12.0f));
+    int cellY = static_cast<int>(std::floor((ypos + dirY * RADIUS) / Real(12.0)));
+    int cellYTarget = static_cast<int>(std::floor((nextGoalY + dirY * RADIUS) / Real(12.0)));
+    int cellX1 = static_cast<int>(std::floor((xpos - RADIUS) / Real(12.0)));
+    int cellX2 = static_cast<int>(std::floor((xpos + RADIUS) / Real(12.0)));
 
     while (cellY != cellYTarget)
     {
@@ -130,14 +130,14 @@ bool DroneBase::chooseNextDirectionAndGoal()
   return false;
 }
 
-std::vector<float> DroneBase::getState(bool minimalState) const
+std::vector<Real> DroneBase::getState(bool minimalState) const
 {
   auto state = Entity::getState(minimalState);
   if (!minimalState)
   {
-    state.push_back(static_cast<float>(mode));
-    state.push_back(dir == -1 ? 0.5f : (static_cast<float>(dir) + 1.0f) / 2.0f);
-    state.push_back(static_cast<float>(orientation) / 7.0f);
+    state.push_back(static_cast<Real>(mode));
+    state.push_back(dir == -1 ? Real(0.5) : (static_cast<Real>(dir) + Real(1.0)) / Real(2.0));
+    state.push_back(static_cast<Real>(orientation) / Real(7.0));
   }
   return state;
 }
\ No newline at end of file
@@ -8,31 +8,31 @@
 class DroneBase : public Entity
 {
 public:
-  static constexpr float RADIUS = 7.5f;
-  static constexpr float GRID_WIDTH = 24.0f;
+  static constexpr Real RADIUS = 7.5;
+  static constexpr Real GRID_WIDTH = 24.0;
 
-  DroneBase(int entityType, Simulation *sim, float xcoord, float ycoord, int orientation, int mode, float speed);
+  DroneBase(int entityType, Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode, Real speed);
 
   void move() override;
   bool isMovable() const override { return true; }
   bool isThinkable() const override { return true; }
-  std::vector<float> getState(bool minimalState = false) const override;
+  std::vector<Real> getState(bool minimalState = false) const override;
 
 protected:
   void turn(int dir);
   virtual bool chooseNextDirectionAndGoal();
   bool testNextDirectionAndGoal(int dir);
 
-  static const std::unordered_map<int, std::array<float, 2>> DIR_TO_VEC;
+  static const std::unordered_map<int, std::array<Real, 2>> DIR_TO_VEC;
   static const std::unordered_map<int, std::array<int, 4>> DIR_LIST;
 
   int dir = -1;
   int dirOld = -1;
   int orientation;
   int mode;
-  float speed;
-  float goalX;
-  float goalY;
-  float xpos2;
-  float ypos2;
+  Real speed;
+  Real goalX;
+  Real goalY;
+  Real xpos2;
+  Real ypos2;
 };
\ No newline at end of file
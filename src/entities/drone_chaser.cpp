@@ -2,7 +2,7 @@
 #include "../physics/physics.hpp"
 #include "../ninja.hpp"
 
-DroneChaser::DroneChaser(Simulation *sim, float xcoord, float ycoord, int orientation, int mode)
+DroneChaser::DroneChaser(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode)
     : DroneZap(sim, xcoord, ycoord, orientation, mode)
 {
 }
@@ -13,9 +13,9 @@ void DroneChaser::think()
   if (!ninja || !ninja->isValidTarget())
     return;
 
-  float dx = ninja->xpos - xpos;
-  float dy = ninja->ypos - ypos;
-  float dist = std::sqrt(dx * dx + dy * dy);
+  Real dx = ninja->xpos - xpos;
+  Real dy = ninja->ypos - ypos;
+  Real dist = std::sqrt(dx * dx + dy * dy);
 
   if (dist > 0)
   {
@@ -33,9 +33,9 @@ bool DroneChaser::chooseNextDirectionAndGoal()
     return DroneZap::chooseNextDirectionAndGoal();
   }
 
-  float dx = ninja->xpos - xpos;
-  float dy = ninja->ypos - ypos;
-  float dist = std::sqrt(dx * dx + dy * dy);
+  Real dx = ninja->xpos - xpos;
+  Real dy = ninja->ypos - ypos;
+  Real dist = std::sqrt(dx * dx + dy * dy);
 
   if (dist > 0)
   {
@@ -8,7 +8,7 @@ public:
   static constexpr int ENTITY_TYPE = 15;
   static constexpr int MAX_COUNT_PER_LEVEL = 256;
 
-  DroneChaser(Simulation *sim, float xcoord, float ycoord, int orientation, int mode);
+  DroneChaser(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode);
 
   void think() override;
 
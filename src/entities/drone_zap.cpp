@@ -2,7 +2,7 @@
 #include "../physics/physics.hpp"
 #include "../ninja.hpp"
 
-DroneZap::DroneZap(Simulation *sim, float xcoord, float ycoord, int orientation, int mode)
+DroneZap::DroneZap(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode)
     : DroneBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, mode, SPEED)
 {
 }
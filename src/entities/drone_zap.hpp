@@ -7,9 +7,9 @@ class DroneZap : public DroneBase
 public:
   static constexpr int ENTITY_TYPE = 14;
   static constexpr int MAX_COUNT_PER_LEVEL = 256;
-  static constexpr float SPEED = 8.0f / 7.0f;
+  static constexpr Real SPEED = Real(8.0) / Real(7.0);
 
-  DroneZap(Simulation *sim, float xcoord, float ycoord, int orientation, int mode);
+  DroneZap(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode);
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
 };
\ No newline at end of file
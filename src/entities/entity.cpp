@@ -4,27 +4,21 @@
 #include <algorithm>
 #include <cmath>
 
-// Initialize static member
-std::array<int, 40> Entity::entityCounts = {};
-
-Entity::Entity(int entityType, Simulation *sim, float xcoord, float ycoord)
+Entity::Entity(int entityType, Simulation *sim, Real xcoord, Real ycoord)
     : entityType(entityType), sim(sim), xpos(xcoord), ypos(ycoord), xposOld(xcoord), yposOld(ycoord)
 {
   // Initialize cell position
   cell = calculateCell();
 
   // Increment entity count for this type
-  if (entityType >= 0 && entityType < 40)
-  {
-    entityCounts[entityType]++;
-  }
+  sim->incrementEntityCount(entityType);
 
   logPositions = sim->getConfig().fullExport;
 }
 
-std::vector<float> Entity::getState(bool minimalState) const
+std::vector<Real> Entity::getState(bool minimalState) const
 {
-  std::vector<float> state;
+  std::vector<Real> state;
   state.reserve(4);
   state.push_back(xpos);
   state.push_back(ypos);
@@ -35,8 +29,9 @@ std::vector<float> Entity::getState(bool minimalState) const
 
 std::pair<int, int> Entity::calculateCell() const
 {
-  return {static_cast<int>(std::floor(xpos / 24)),
-          static_cast<int>(std::floor(ypos / 24))};
+  // Clamped so entities outside the playfield still map to a valid grid cell
+  return clampCell(static_cast<int>(std::floor(xpos / 24)),
+                   static_cast<int>(std::floor(ypos / 24)));
 }
 
 void Entity::gridMove()
@@ -44,19 +39,23 @@ void Entity::gridMove()
   auto newCell = calculateCell();
   if (newCell != cell)
   {
-    // Remove from old cell
-    auto &oldCellEntities = sim->getEntitiesAt(cell);
-    auto it = std::find_if(oldCellEntities.begin(), oldCellEntities.end(),
-                           [this](const auto &e)
-                           { return e.get() == this; });
-    if (it != oldCellEntities.end())
+    // Both grid updates are O(1) through the slot this entity keeps in its cell list
+    sim->removeEntityFromGrid(this);
+    cell = newCell;
+    sim->addEntityToGrid(this);
+  }
+}
+
+void Entity::setActive(bool isActive)
+{
+  if (active != isActive)
+  {
+    active = isActive;
+    sim->invalidateEntityNeighbourhood();
+    if (isMovable() || isThinkable())
     {
-      oldCellEntities.erase(it);
+      sim->updateActiveEntities(getType());
     }
-
-    // Add to new cell
-    sim->getEntitiesAt(newCell).push_back(std::shared_ptr<Entity>(this, [](Entity *) {})); // Non-owning shared_ptr
-    cell = newCell;
   }
 }
 
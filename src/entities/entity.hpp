@@ -14,11 +14,10 @@ class Simulation;
 class Entity
 {
 public:
-  // Static members
-  static std::array<int, 40> entityCounts;
+  static constexpr size_t NOT_IN_GRID = static_cast<size_t>(-1);
 
   // Constructor
-  Entity(int entityType, Simulation *sim, float xcoord, float ycoord);
+  Entity(int entityType, Simulation *sim, Real xcoord, Real ycoord);
   virtual ~Entity() = default;
 
   // Virtual methods that can be overridden by derived classes
@@ -28,7 +27,7 @@ public:
   virtual std::optional<EntityCollisionResult> logicalCollision() { return std::nullopt; }
 
   // State getters/setters
-  virtual std::vector<float> getState(bool minimalState = false) const;
+  virtual std::vector<Real> getState(bool minimalState = false) const;
   void gridMove();
   void logCollision(int state = 1);
   void logPosition();
@@ -39,51 +38,53 @@ public:
   virtual bool isThinkable() const { return false; }
   virtual bool isLogicalCollidable() const { return false; }
   virtual bool isPhysicalCollidable() const { return false; }
-  virtual int getType() const { return type; }
+  virtual int getType() const { return entityType; }
   virtual std::pair<int, int> getCell() const { return cell; }
 
   // Getters
   int getEntityType() const { return entityType; }
   Simulation *getSimulation() const { return sim; }
-  float getXPos() const { return xpos; }
-  float getYPos() const { return ypos; }
-  float getXSpeed() const { return xspeed; }
-  float getYSpeed() const { return yspeed; }
-  float getXPosOld() const { return xposOld; }
-  float getYPosOld() const { return yposOld; }
+  Real getXPos() const { return xpos; }
+  Real getYPos() const { return ypos; }
+  Real getXSpeed() const { return xspeed; }
+  Real getYSpeed() const { return yspeed; }
+  Real getXPosOld() const { return xposOld; }
+  Real getYPosOld() const { return yposOld; }
+  size_t getGridSlot() const { return gridSlot; }
 
   // Setters
   void setEntityType(int type) { entityType = type; }
   void setSimulation(Simulation *simulation) { sim = simulation; }
-  void setXPos(float x) { xpos = x; }
-  void setYPos(float y) { ypos = y; }
-  void setXSpeed(float xs) { xspeed = xs; }
-  void setYSpeed(float ys) { yspeed = ys; }
-  void setXPosOld(float x) { xposOld = x; }
-  void setYPosOld(float y) { yposOld = y; }
-  void setActive(bool isActive) { active = isActive; }
+  void setXPos(Real x) { xpos = x; }
+  void setYPos(Real y) { ypos = y; }
+  void setXSpeed(Real xs) { xspeed = xs; }
+  void setYSpeed(Real ys) { yspeed = ys; }
+  void setXPosOld(Real x) { xposOld = x; }
+  void setYPosOld(Real y) { yposOld = y; }
+  void setGridSlot(size_t slot) { gridSlot = slot; }
+  void setActive(bool isActive);
 
 protected:
   // Protected member variables for derived classes
   int entityType;
   Simulation *sim;
-  float xpos;
-  float ypos;
-  float xspeed = 0.0f;
-  float yspeed = 0.0f;
-  float xposOld;
-  float yposOld;
-  std::vector<std::tuple<int, float, float>> posLog;
-  std::vector<std::tuple<int, float, float>> speedLog;
+  Real xpos;
+  Real ypos;
+  Real xspeed = 0.0;
+  Real yspeed = 0.0;
+  Real xposOld;
+  Real yposOld;
+  std::vector<std::tuple<int, Real, Real>> posLog;
+  std::vector<std::tuple<int, Real, Real>> speedLog;
   std::vector<int> collisionLog;
   bool active = true;
   bool logPositions = false;
   bool logCollisions = true;
-  int type = 0;
   std::pair<int, int> cell;
+  size_t gridSlot = NOT_IN_GRID; // Index of this entity in its grid cell list
   int lastExportedState = -1;
   int lastExportedFrame = -1;
-  std::pair<float, float> lastExportedCoords;
+  std::pair<Real, Real> lastExportedCoords;
   std::vector<int> exportedChunks;
 
   std::pair<int, int> calculateCell() const;
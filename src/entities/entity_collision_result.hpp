@@ -1,5 +1,7 @@
 #pragma once
 
+#include "../real.hpp"
+
 #include <optional>
 #include <utility>
 
@@ -21,20 +23,20 @@
 class EntityCollisionResult
 {
 public:
-  EntityCollisionResult(float r1val,
-                        std::optional<float> r2val = std::nullopt,
-                        std::optional<float> r3val = std::nullopt,
-                        std::optional<float> r4val = std::nullopt)
+  EntityCollisionResult(Real r1val,
+                        std::optional<Real> r2val = std::nullopt,
+                        std::optional<Real> r3val = std::nullopt,
+                        std::optional<Real> r4val = std::nullopt)
       : r1(r1val), r2(r2val), r3(r3val), r4(r4val) {}
 
-  float getR1() const { return r1; }
-  std::optional<float> getR2() const { return r2; }
-  std::optional<float> getR3() const { return r3; }
-  std::optional<float> getR4() const { return r4; }
+  Real getR1() const { return r1; }
+  std::optional<Real> getR2() const { return r2; }
+  std::optional<Real> getR3() const { return r3; }
+  std::optional<Real> getR4() const { return r4; }
 
 private:
-  const float r1;
-  const std::optional<float> r2;
-  const std::optional<float> r3;
-  const std::optional<float> r4;
+  const Real r1;
+  const std::optional<Real> r2;
+  const std::optional<Real> r3;
+  const std::optional<Real> r4;
 };
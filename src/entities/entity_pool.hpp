@@ -0,0 +1,145 @@
+#pragma once
+
+#include "toggle_mine.hpp"
+#include "gold.hpp"
+#include "exit_door.hpp"
+#include "exit_switch.hpp"
+#include "door_regular.hpp"
+#include "door_locked.hpp"
+#include "door_trap.hpp"
+#include "launch_pad.hpp"
+#include "one_way_platform.hpp"
+#include "drone_zap.hpp"
+#include "bounce_block.hpp"
+#include "thwump.hpp"
+#include "boost_pad.hpp"
+#include "death_ball.hpp"
+#include "mini_drone.hpp"
+#include "shove_thwump.hpp"
+
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <stdexcept>
+
+// Contiguous storage for every entity of one concrete type
+template <typename T>
+struct EntityPool
+{
+  using Type = T;
+
+  std::vector<T> entities; // Reserved before loading so entity addresses stay stable
+  std::vector<T *> active; // Active entities in entityDic order
+
+  template <typename... Args>
+  T *create(Args &&...args)
+  {
+    if (entities.size() == entities.capacity())
+    {
+      throw std::length_error("Entity pool capacity exceeded");
+    }
+    return &entities.emplace_back(std::forward<Args>(args)...);
+  }
+
+  void clear()
+  {
+    entities.clear();
+    active.clear();
+  }
+
+  // The qualified calls below are bound at compile time, so the per-type
+  // loops never go through the vtable.
+  void moveAll()
+  {
+    for (T *entity : active)
+    {
+      if (entity->T::isMovable())
+      {
+        entity->T::move();
+      }
+    }
+  }
+
+  void thinkAll()
+  {
+    for (T *entity : active)
+    {
+      if (entity->T::isThinkable())
+      {
+        entity->T::think();
+      }
+    }
+  }
+
+  void logPositions()
+  {
+    for (T *entity : active)
+    {
+      if (entity->T::isMovable())
+      {
+        entity->logPosition();
+      }
+    }
+  }
+};
+
+// One pool per entity type the simulation creates, in ascending type order
+struct EntityPools
+{
+  std::tuple<EntityPool<ToggleMine>,
+             EntityPool<Gold>,
+             EntityPool<ExitDoor>,
+             EntityPool<ExitSwitch>,
+             EntityPool<DoorRegular>,
+             EntityPool<DoorLocked>,
+             EntityPool<DoorTrap>,
+             EntityPool<LaunchPad>,
+             EntityPool<OneWayPlatform>,
+             EntityPool<DroneZap>,
+             EntityPool<BounceBlock>,
+             EntityPool<Thwump>,
+             EntityPool<BoostPad>,
+             EntityPool<DeathBall>,
+             EntityPool<MiniDrone>,
+             EntityPool<ShoveThwump>>
+      pools;
+
+  template <typename Visitor>
+  void forEach(Visitor &&visitor)
+  {
+    std::apply([&](auto &...pool)
+               { (visitor(pool), ...); },
+               pools);
+  }
+
+  // After copying the entities of source, whose pools hold the same number
+  // of entities of each type, point the copies' active lists and exit switch
+  // doors at the copied entities instead of source's, and the copies at sim.
+  void rebase(const EntityPools &source, Simulation *sim)
+  {
+    std::apply([&](auto &...pool)
+               { (rebasePool(pool, std::get<std::decay_t<decltype(pool)>>(source.pools), sim), ...); },
+               pools);
+
+    auto &doors = std::get<EntityPool<ExitDoor>>(pools).entities;
+    const auto &sourceDoors = std::get<EntityPool<ExitDoor>>(source.pools).entities;
+    for (auto &exitSwitch : std::get<EntityPool<ExitSwitch>>(pools).entities)
+    {
+      exitSwitch.setParent(&doors[exitSwitch.getParent() - sourceDoors.data()]);
+    }
+  }
+
+private:
+  template <typename T>
+  static void rebasePool(EntityPool<T> &pool, const EntityPool<T> &source, Simulation *sim)
+  {
+    for (auto &entity : pool.entities)
+    {
+      entity.setSimulation(sim);
+    }
+    for (auto &entity : pool.active)
+    {
+      entity = &pool.entities[entity - source.entities.data()];
+    }
+  }
+};
\ No newline at end of file
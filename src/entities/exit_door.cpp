@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-ExitDoor::ExitDoor(Simulation *sim, float xcoord, float ycoord)
+ExitDoor::ExitDoor(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
 }
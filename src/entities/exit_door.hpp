@@ -5,11 +5,11 @@
 class ExitDoor : public Entity
 {
 public:
-  ExitDoor(Simulation *sim, float xcoord, float ycoord);
+  ExitDoor(Simulation *sim, Real xcoord, Real ycoord);
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
 
   static constexpr int ENTITY_TYPE = 3;
-  static constexpr float RADIUS = 12.0f;
+  static constexpr Real RADIUS = 12.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 16;
 };
\ No newline at end of file
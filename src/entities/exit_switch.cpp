@@ -4,7 +4,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-ExitSwitch::ExitSwitch(Simulation *sim, float xcoord, float ycoord, ExitDoor *parent)
+ExitSwitch::ExitSwitch(Simulation *sim, Real xcoord, Real ycoord, ExitDoor *parent)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord), parent(parent)
 {
 }
@@ -17,7 +17,7 @@ std::optional<EntityCollisionResult> ExitSwitch::logicalCollision()
           ninja->xpos, ninja->ypos, ninja->RADIUS))
   {
     setActive(false);
-    sim->addEntity(std::shared_ptr<Entity>(parent));
+    sim->addEntityToGrid(parent);
     logCollision();
   }
   return std::nullopt;
@@ -6,12 +6,15 @@
 class ExitSwitch : public Entity
 {
 public:
-  ExitSwitch(Simulation *sim, float xcoord, float ycoord, ExitDoor *parent);
+  ExitSwitch(Simulation *sim, Real xcoord, Real ycoord, ExitDoor *parent);
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
 
+  ExitDoor *getParent() const { return parent; }
+  void setParent(ExitDoor *door) { parent = door; }
+
   static constexpr int ENTITY_TYPE = 4;
-  static constexpr float RADIUS = 6.0f;
+  static constexpr Real RADIUS = 6.0;
 
 private:
   ExitDoor *parent;
@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-Gold::Gold(Simulation *sim, float xcoord, float ycoord)
+Gold::Gold(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
 }
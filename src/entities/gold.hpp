@@ -5,11 +5,11 @@
 class Gold : public Entity
 {
 public:
-  Gold(Simulation *sim, float xcoord, float ycoord);
+  Gold(Simulation *sim, Real xcoord, Real ycoord);
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
 
   static constexpr int ENTITY_TYPE = 2;
-  static constexpr float RADIUS = 6.0f;
+  static constexpr Real RADIUS = 6.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 8192;
 };
\ No newline at end of file
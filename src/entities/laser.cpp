@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include <cmath>
 
-Laser::Laser(Simulation *sim, float xcoord, float ycoord, int orientation, int mode)
+Laser::Laser(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord),
       orientation(orientation),
       mode(mode),
@@ -12,14 +12,14 @@ Laser::Laser(Simulation *sim, float xcoord, float ycoord, int orientation, int m
 {
   if (mode == 0)
   {
-    angle = orientation * M_PI / 4.0f;
+    angle = orientation * M_PI / Real(4.0);
     clockwise = orientation >= 4;
   }
   else
   {
     auto [dirX, dirY] = Physics::mapOrientationToVector(orientation);
-    xend = xstart + 24.0f * dirX;
-    yend = ystart + 24.0f * dirY;
+    xend = xstart + Real(24.0) * dirX;
+    yend = ystart + Real(24.0) * dirY;
     clockwise = mode >= 3;
   }
 }
@@ -37,7 +37,7 @@ void Laser::think()
 
   if (Physics::overlapCircleVsCircle(xpos, ypos, RADIUS, ninja->xpos, ninja->ypos, ninja->RADIUS))
   {
-    ninja->kill(0, xpos, ypos, 0.0f, 0.0f);
+    ninja->kill(0, xpos, ypos, Real(0.0), Real(0.0));
   }
 }
 
@@ -48,10 +48,10 @@ void Laser::thinkSpinner()
   else
     angle -= SPIN_SPEED;
 
-  if (angle < 0.0f)
-    angle += 2.0f * M_PI;
-  else if (angle >= 2.0f * M_PI)
-    angle -= 2.0f * M_PI;
+  if (angle < 0)
+    angle += Real(2.0) * M_PI;
+  else if (angle >= 2 * M_PI)
+    angle -= Real(2.0) * M_PI;
 
   xpos = xstart + RADIUS * std::cos(angle);
   ypos = ystart + RADIUS * std::sin(angle);
@@ -64,26 +64,26 @@ void Laser::thinkSurface()
   else
     progress -= SURFACE_FLAT_SPEED;
 
-  if (progress < 0.0f || progress > 1.0f)
+  if (progress < 0 || progress > 1)
   {
     clockwise = !clockwise;
-    progress = std::clamp(progress, 0.0f, 1.0f);
+    progress = std::clamp(progress, Real(0.0), Real(1.0));
   }
 
   xpos = xstart + (xend - xstart) * progress;
   ypos = ystart + (yend - ystart) * progress;
 }
 
-std::vector<float> Laser::getState(bool minimalState) const
+std::vector<Real> Laser::getState(bool minimalState) const
 {
   auto state = Entity::getState(minimalState);
   if (!minimalState)
   {
-    state.push_back(static_cast<float>(orientation));
-    state.push_back(static_cast<float>(mode));
+    state.push_back(static_cast<Real>(orientation));
+    state.push_back(static_cast<Real>(mode));
     state.push_back(angle);
     state.push_back(progress);
-    state.push_back(clockwise ? 1.0f : 0.0f);
+    state.push_back(clockwise ? Real(1.0) : Real(0.0));
   }
   return state;
 }
\ No newline at end of file
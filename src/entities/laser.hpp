@@ -7,16 +7,16 @@ class Laser : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 23;
-  static constexpr float RADIUS = 5.9f;
-  static constexpr float SPIN_SPEED = 0.010471975f; // roughly 2pi/600
-  static constexpr float SURFACE_FLAT_SPEED = 0.1f;
-  static constexpr float SURFACE_CORNER_SPEED = 0.005524805665672641f; // roughly 0.1/(5.9*pi)
+  static constexpr Real RADIUS = 5.9;
+  static constexpr Real SPIN_SPEED = 0.010471975; // roughly 2pi/600
+  static constexpr Real SURFACE_FLAT_SPEED = 0.1;
+  static constexpr Real SURFACE_CORNER_SPEED = 0.005524805665672641; // roughly 0.1/(5.9*pi)
 
-  Laser(Simulation *sim, float xcoord, float ycoord, int orientation, int mode);
+  Laser(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode);
 
   void think() override;
   bool isThinkable() const override { return true; }
-  std::vector<float> getState(bool minimalState = false) const override;
+  std::vector<Real> getState(bool minimalState = false) const override;
 
 private:
   void thinkSpinner();
@@ -24,11 +24,11 @@ private:
 
   int orientation;
   int mode;
-  float angle = 0.0f;
-  float xstart;
-  float ystart;
-  float xend;
-  float yend;
-  float progress = 0.0f;
+  Real angle = 0.0;
+  Real xstart;
+  Real ystart;
+  Real xend;
+  Real yend;
+  Real progress = 0.0;
   bool clockwise = false;
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "../physics/physics.hpp"
 #include "../ninja.hpp"
 
-LaunchPad::LaunchPad(Simulation *sim, float xcoord, float ycoord, int orientation)
+LaunchPad::LaunchPad(Simulation *sim, Real xcoord, Real ycoord, int orientation)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord), orientation(orientation)
 {
 }
@@ -19,16 +19,16 @@ std::optional<EntityCollisionResult> LaunchPad::logicalCollision()
 
     if ((xpos - (ninja->xpos - ninja->RADIUS * normalX)) * normalX +
             (ypos - (ninja->ypos - ninja->RADIUS * normalY)) * normalY >=
-        -0.1f)
+        Real(-0.1))
     {
-      float yboostScale = 1.0f;
+      Real yboostScale = 1.0;
       if (normalY < 0)
       {
-        yboostScale = 1.0f - normalY;
+        yboostScale = Real(1.0) - normalY;
       }
 
-      float xboost = normalX * BOOST;
-      float yboost = normalY * BOOST * yboostScale;
+      Real xboost = normalX * BOOST;
+      Real yboost = normalY * BOOST * yboostScale;
 
       return EntityCollisionResult{xboost, yboost};
     }
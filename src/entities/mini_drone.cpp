@@ -1,8 +1,8 @@
 #include "mini_drone.hpp"
 #include "../physics/physics.hpp"
 
-MiniDrone::MiniDrone(Simulation *sim, float xcoord, float ycoord, int orientation, int mode)
-    : DroneBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, mode, 1.3f)
+MiniDrone::MiniDrone(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode)
+    : DroneBase(ENTITY_TYPE, sim, xcoord, ycoord, orientation, mode, Real(1.3))
 {
 }
 
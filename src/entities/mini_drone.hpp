@@ -5,12 +5,12 @@
 class MiniDrone : public DroneBase
 {
 public:
-  MiniDrone(Simulation *sim, float xcoord, float ycoord, int orientation, int mode);
+  MiniDrone(Simulation *sim, Real xcoord, Real ycoord, int orientation, int mode);
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
 
   static constexpr int ENTITY_TYPE = 26;
-  static constexpr float RADIUS = 4.0f;
-  static constexpr float GRID_WIDTH = 12.0f;
+  static constexpr Real RADIUS = 4.0;
+  static constexpr Real GRID_WIDTH = 12.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 512;
 };
\ No newline at end of file
@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-OneWayPlatform::OneWayPlatform(Simulation *sim, float xcoord, float ycoord, int orientation)
+OneWayPlatform::OneWayPlatform(Simulation *sim, Real xcoord, Real ycoord, int orientation)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord), orientation(orientation)
 {
   auto vec = Physics::mapOrientationToVector(orientation);
@@ -39,32 +39,32 @@ std::optional<EntityCollisionResult> OneWayPlatform::logicalCollision()
   return std::nullopt;
 }
 
-std::optional<std::tuple<std::pair<float, float>, std::pair<float, float>>>
+std::optional<std::tuple<std::pair<Real, Real>, std::pair<Real, Real>>>
 OneWayPlatform::calculateDepenetration(const Ninja *ninja) const
 {
-  float dx = ninja->xpos - xpos;
-  float dy = ninja->ypos - ypos;
-  float lateralDist = dx * normalY - dy * normalX;
+  Real dx = ninja->xpos - xpos;
+  Real dy = ninja->ypos - ypos;
+  Real lateralDist = dx * normalY - dy * normalX;
   int direction = lateralDist < 0 ? -1 : 1;
 
   // The platform has a bigger width if the ninja is moving towards its center
-  float radiusScalar = direction < 0 ? 0.91f : 0.51f;
+  Real radiusScalar = direction < 0 ? Real(0.91) : Real(0.51);
   if (std::abs(lateralDist) < radiusScalar * ninja->RADIUS + SEMI_SIDE)
   {
-    float normalDist = dx * normalX + dy * normalY;
+    Real normalDist = dx * normalX + dy * normalY;
     if (0 < normalDist && normalDist <= ninja->RADIUS)
     {
-      float normalProj = ninja->xspeed * normalX + ninja->yspeed * normalY;
+      Real normalProj = ninja->xspeed * normalX + ninja->yspeed * normalY;
       if (normalProj <= 0)
       {
-        float dxOld = ninja->xposOld - xpos;
-        float dyOld = ninja->yposOld - ypos;
-        float normalDistOld = dxOld * normalX + dyOld * normalY;
-        if (ninja->RADIUS - normalDistOld <= 1.1f)
+        Real dxOld = ninja->xposOld - xpos;
+        Real dyOld = ninja->yposOld - ypos;
+        Real normalDistOld = dxOld * normalX + dyOld * normalY;
+        if (ninja->RADIUS - normalDistOld <= Real(1.1))
         {
           return std::make_tuple(
               std::make_pair(normalX, normalY),
-              std::make_pair(ninja->RADIUS - normalDist, 0.0f));
+              std::make_pair(ninja->RADIUS - normalDist, Real(0.0)));
         }
       }
     }
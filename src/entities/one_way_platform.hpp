@@ -8,21 +8,21 @@ class OneWayPlatform : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 11;
-  static constexpr float SEMI_SIDE = 12.0f;
+  static constexpr Real SEMI_SIDE = 12.0;
   static constexpr int MAX_COUNT_PER_LEVEL = 512;
 
-  OneWayPlatform(Simulation *sim, float xcoord, float ycoord, int orientation);
+  OneWayPlatform(Simulation *sim, Real xcoord, Real ycoord, int orientation);
 
   std::optional<EntityCollisionResult> physicalCollision() override;
   std::optional<EntityCollisionResult> logicalCollision() override;
   bool isLogicalCollidable() const override { return true; }
   bool isPhysicalCollidable() const override { return true; }
 
-  std::optional<std::tuple<std::pair<float, float>, std::pair<float, float>>>
+  std::optional<std::tuple<std::pair<Real, Real>, std::pair<Real, Real>>>
   calculateDepenetration(const Ninja *ninja) const;
 
 private:
   int orientation;
-  float normalX;
-  float normalY;
+  Real normalX;
+  Real normalY;
 };
\ No newline at end of file
@@ -2,7 +2,7 @@
 #include "../physics/physics.hpp"
 #include "../ninja.hpp"
 
-ShoveThwump::ShoveThwump(Simulation *sim, float xcoord, float ycoord)
+ShoveThwump::ShoveThwump(Simulation *sim, Real xcoord, Real ycoord)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord), xorigin(xcoord), yorigin(ycoord)
 {
 }
@@ -12,20 +12,20 @@ void ShoveThwump::setState(int newState)
   state = newState;
 }
 
-bool ShoveThwump::moveIfPossible(float xdir, float ydir, float speed)
+bool ShoveThwump::moveIfPossible(Real xdir, Real ydir, Real speed)
 {
-  if (ydir == 0.0f)
+  if (ydir == 0)
   {
-    float xposNew = xpos + xdir * speed;
-    int cellX = static_cast<int>(xpos / 12.0f);
-    int cellXNew = static_cast<int>(xposNew / 12.0f);
+    Real xposNew = xpos + xdir * speed;
+    int cellX = static_cast<int>(xpos / Real(12.0));
+    int cellXNew = static_cast<int>(xposNew / Real(12.0));
 
     if (cellX != cellXNew)
     {
-      int cellY1 = static_cast<int>((ypos - 8.0f) / 12.0f);
-      int cellY2 = static_cast<int>((ypos + 8.0f) / 12.0f);
+      int cellY1 = static_cast<int>((ypos - Real(8.0)) / Real(12.0));
+      int cellY2 = static_cast<int>((ypos + Real(8.0)) / Real(12.0));
 
-      if (!Physics::isEmptyColumn(*sim, cellX, cellY1, cellY2, xdir > 0.0f ? 1 : -1))
+      if (!Physics::isEmptyColumn(*sim, cellX, cellY1, cellY2, xdir > 0 ? 1 : -1))
       {
         setState(3);
         return false;
@@ -35,16 +35,16 @@ bool ShoveThwump::moveIfPossible(float xdir, float ydir, float speed)
   }
   else
   {
-    float yposNew = ypos + ydir * speed;
-    int cellY = static_cast<int>(ypos / 12.0f);
-    int cellYNew = static_cast<int>(yposNew / 12.0f);
+    Real yposNew = ypos + ydir * speed;
+    int cellY = static_cast<int>(ypos / Real(12.0));
+    int cellYNew = static_cast<int>(yposNew / Real(12.0));
 
     if (cellY != cellYNew)
     {
-      int cellX1 = static_cast<int>((xpos - 8.0f) / 12.0f);
-      int cellX2 = static_cast<int>((xpos + 8.0f) / 12.0f);
+      int cellX1 = static_cast<int>((xpos - Real(8.0)) / Real(12.0));
+      int cellX2 = static_cast<int>((xpos + Real(8.0)) / Real(12.0));
 
-      if (!Physics::isEmptyRow(*sim, cellX1, cellX2, cellY, ydir > 0.0f ? 1 : -1))
+      if (!Physics::isEmptyRow(*sim, cellX1, cellX2, cellY, ydir > 0 ? 1 : -1))
       {
         setState(3);
         return false;
@@ -70,10 +70,10 @@ void ShoveThwump::think()
   }
   else if (state == 3)
   {
-    float originDist = std::abs(xpos - xorigin) + std::abs(ypos - yorigin);
-    if (originDist >= 1.0f)
+    Real originDist = std::abs(xpos - xorigin) + std::abs(ypos - yorigin);
+    if (originDist >= 1)
     {
-      moveIfPossible(xdir, ydir, 1.0f);
+      moveIfPossible(xdir, ydir, Real(1.0));
     }
     else
     {
@@ -84,7 +84,7 @@ void ShoveThwump::think()
   }
   else if (state == 2)
   {
-    moveIfPossible(-xdir, -ydir, 4.0f);
+    moveIfPossible(-xdir, -ydir, Real(4.0));
   }
 }
 
@@ -110,7 +110,7 @@ std::optional<EntityCollisionResult> ShoveThwump::physicalCollision()
     const auto &[normal, penetrations] = *depen;
     const auto &[depenX, depenY] = normal;
 
-    if (state == 0 || xdir * depenX + ydir * depenY >= 0.01f)
+    if (state == 0 || xdir * depenX + ydir * depenY >= Real(0.01))
     {
       return EntityCollisionResult(depenX, depenY, penetrations.first, penetrations.second);
     }
@@ -125,7 +125,7 @@ std::optional<EntityCollisionResult> ShoveThwump::logicalCollision()
   if (!ninja || !ninja->isValidTarget())
     return std::nullopt;
 
-  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + ninja->RADIUS + 0.1f);
+  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + ninja->RADIUS + Real(0.1));
   if (depen && state <= 1)
   {
     const auto &[normal, penetrations] = *depen;
@@ -134,7 +134,7 @@ std::optional<EntityCollisionResult> ShoveThwump::logicalCollision()
     if (state == 0)
     {
       activated = true;
-      if (penetrations.second > 0.2f)
+      if (penetrations.second > Real(0.2))
       {
         xdir = depenX;
         ydir = depenY;
@@ -143,7 +143,7 @@ std::optional<EntityCollisionResult> ShoveThwump::logicalCollision()
     }
     else if (state == 1)
     {
-      if (xdir * depenX + ydir * depenY >= 0.01f)
+      if (xdir * depenX + ydir * depenY >= Real(0.01))
       {
         activated = true;
       }
@@ -152,12 +152,12 @@ std::optional<EntityCollisionResult> ShoveThwump::logicalCollision()
         return std::nullopt;
       }
     }
-    return EntityCollisionResult(depenX, 0.0f, 0.0f, 0.0f);
+    return EntityCollisionResult(depenX, Real(0.0), Real(0.0), Real(0.0));
   }
 
   if (Physics::overlapCircleVsCircle(ninja->xpos, ninja->ypos, ninja->RADIUS, xpos, ypos, RADIUS))
   {
-    ninja->kill(0, 0.0f, 0.0f, 0.0f, 0.0f);
+    ninja->kill(0, Real(0.0), Real(0.0), Real(0.0), Real(0.0));
   }
 
   return std::nullopt;
@@ -7,11 +7,11 @@ class ShoveThwump : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 28;
-  static constexpr float SEMI_SIDE = 12.0f;
-  static constexpr float RADIUS = 8.0f; // for the projectile inside
+  static constexpr Real SEMI_SIDE = 12.0;
+  static constexpr Real RADIUS = 8.0; // for the projectile inside
   static constexpr int MAX_COUNT_PER_LEVEL = 128;
 
-  ShoveThwump(Simulation *sim, float xcoord, float ycoord);
+  ShoveThwump(Simulation *sim, Real xcoord, Real ycoord);
 
   void think() override;
   void move() override;
@@ -23,13 +23,13 @@ public:
   bool isThinkable() const override { return true; }
 
 private:
-  float xorigin;
-  float yorigin;
-  float xdir = 0.0f;
-  float ydir = 0.0f;
+  Real xorigin;
+  Real yorigin;
+  Real xdir = 0.0;
+  Real ydir = 0.0;
   bool activated = false;
   int state = 0; // 0:immobile, 1:activated, 2:launching, 3:retreating
 
   void setState(int newState);
-  bool moveIfPossible(float xdir, float ydir, float speed);
+  bool moveIfPossible(Real xdir, Real ydir, Real speed);
 };
\ No newline at end of file
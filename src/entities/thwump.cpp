@@ -3,7 +3,7 @@
 #include "../ninja.hpp"
 #include "../physics/physics.hpp"
 
-Thwump::Thwump(Simulation *sim, float xcoord, float ycoord, int orientation)
+Thwump::Thwump(Simulation *sim, Real xcoord, Real ycoord, int orientation)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord), orientation(orientation),
       xstart(xcoord), ystart(ycoord)
 {
@@ -21,18 +21,23 @@ void Thwump::think()
       return;
 
     // Check if ninja is in activation range
-    float dx = ninja->xpos - xpos;
-    float dy = ninja->ypos - ypos;
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = ninja->xpos - xpos;
+    Real dy = ninja->ypos - ypos;
+    Real dist = std::sqrt(dx * dx + dy * dy);
 
     if (dist > 0)
     {
       dx /= dist;
       dy /= dist;
-      if (dx * dirX + dy * dirY > 0.9f)
+      if (dx * dirX + dy * dirY > Real(0.9))
       {
-        // Check if there's a clear line of sight to the ninja
-        if (!Physics::raycastVsPlayer(*sim, xpos, ypos, ninja->xpos, ninja->ypos, ninja->RADIUS))
+        // Check if there's a clear line of sight to the ninja. Idle thwumps
+        // sit at their start position, where the test is usually static.
+        if (!sightAlwaysClear)
+        {
+          sightAlwaysClear = Physics::isRaycastVsPlayerStatic(*sim, xstart, ystart);
+        }
+        if (*sightAlwaysClear || !Physics::raycastVsPlayer(*sim, xpos, ypos, ninja->xpos, ninja->ypos, ninja->RADIUS))
         {
           setState(1);
         }
@@ -74,15 +79,15 @@ void Thwump::think()
     }
 
     // Check if we've gone too far from start
-    float dx = xpos - xstart;
-    float dy = ypos - ystart;
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = xpos - xstart;
+    Real dy = ypos - ystart;
+    Real dist = std::sqrt(dx * dx + dy * dy);
 
     if (dist > 0)
     {
       dx /= dist;
       dy /= dist;
-      if (dx * dirX + dy * dirY > 0.9f)
+      if (dx * dirX + dy * dirY > Real(0.9))
       {
         setState(2);
       }
@@ -91,9 +96,9 @@ void Thwump::think()
   else if (state == 2)
   {
     // Check if we're close enough to starting position to reset
-    float dx = xpos - xstart;
-    float dy = ypos - ystart;
-    if (dx * dx + dy * dy < 1.0f)
+    Real dx = xpos - xstart;
+    Real dy = ypos - ystart;
+    if (dx * dx + dy * dy < 1)
     {
       xpos = xstart;
       ypos = ystart;
@@ -114,9 +119,9 @@ void Thwump::move()
   }
   else if (state == 2)
   {
-    float dx = xstart - xpos;
-    float dy = ystart - ypos;
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dx = xstart - xpos;
+    Real dy = ystart - ypos;
+    Real dist = std::sqrt(dx * dx + dy * dy);
     if (dist > 0)
     {
       dx /= dist;
@@ -149,7 +154,7 @@ std::optional<EntityCollisionResult> Thwump::logicalCollision()
   if (!ninja || !ninja->isValidTarget())
     return std::nullopt;
 
-  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + 0.1f);
+  auto depen = Physics::penetrationSquareVsPoint(xpos, ypos, ninja->xpos, ninja->ypos, SEMI_SIDE + Real(0.1));
   if (!depen)
     return std::nullopt;
 
@@ -158,12 +163,12 @@ std::optional<EntityCollisionResult> Thwump::logicalCollision()
   // Check for lethal collision with charging face
   if (isHorizontal)
   {
-    float dx = (SEMI_SIDE + 2) * dirX;
-    float dy = SEMI_SIDE - 2;
-    float px1 = xpos + dx;
-    float py1 = ypos - dy;
-    float px2 = xpos + dx;
-    float py2 = ypos + dy;
+    Real dx = (SEMI_SIDE + 2) * dirX;
+    Real dy = SEMI_SIDE - 2;
+    Real px1 = xpos + dx;
+    Real py1 = ypos - dy;
+    Real px2 = xpos + dx;
+    Real py2 = ypos + dy;
 
     if (Physics::overlapCircleVsSegment(ninja->xpos, ninja->ypos, ninja->RADIUS + 2, px1, py1, px2, py2))
     {
@@ -172,12 +177,12 @@ std::optional<EntityCollisionResult> Thwump::logicalCollision()
   }
   else
   {
-    float dx = SEMI_SIDE - 2;
-    float dy = (SEMI_SIDE + 2) * dirY;
-    float px1 = xpos - dx;
-    float py1 = ypos + dy;
-    float px2 = xpos + dx;
-    float py2 = ypos + dy;
+    Real dx = SEMI_SIDE - 2;
+    Real dy = (SEMI_SIDE + 2) * dirY;
+    Real px1 = xpos - dx;
+    Real py1 = ypos + dy;
+    Real px2 = xpos + dx;
+    Real py2 = ypos + dy;
 
     if (Physics::overlapCircleVsSegment(ninja->xpos, ninja->ypos, ninja->RADIUS + 2, px1, py1, px2, py2))
     {
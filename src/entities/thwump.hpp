@@ -7,12 +7,12 @@ class Thwump : public Entity
 {
 public:
   static constexpr int ENTITY_TYPE = 20;
-  static constexpr float SEMI_SIDE = 9.0f;
-  static constexpr float FORWARD_SPEED = 20.0f / 7.0f;
-  static constexpr float BACKWARD_SPEED = 8.0f / 7.0f;
+  static constexpr Real SEMI_SIDE = 9.0;
+  static constexpr Real FORWARD_SPEED = Real(20.0) / Real(7.0);
+  static constexpr Real BACKWARD_SPEED = Real(8.0) / Real(7.0);
   static constexpr int MAX_COUNT_PER_LEVEL = 128;
 
-  Thwump(Simulation *sim, float xcoord, float ycoord, int orientation);
+  Thwump(Simulation *sim, Real xcoord, Real ycoord, int orientation);
 
   void think() override;
   void move() override;
@@ -28,9 +28,12 @@ private:
 
   int orientation;
   int state = 0; // 0: idle, 1: charging forward, 2: returning
-  float xstart;
-  float ystart;
+  Real xstart;
+  Real ystart;
+  // Whether the line of sight test from the start position never stops the
+  // thwump, filled on the first idle think once the doors are loaded
+  std::optional<bool> sightAlwaysClear;
   bool isHorizontal;
-  float dirX;
-  float dirY;
+  Real dirX;
+  Real dirY;
 };
\ No newline at end of file
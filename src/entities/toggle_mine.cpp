@@ -2,7 +2,7 @@
 #include "../simulation.hpp"
 #include "../ninja.hpp"
 
-ToggleMine::ToggleMine(Simulation *sim, float xcoord, float ycoord, int state)
+ToggleMine::ToggleMine(Simulation *sim, Real xcoord, Real ycoord, int state)
     : Entity(ENTITY_TYPE, sim, xcoord, ycoord)
 {
   setState(state);
@@ -68,7 +68,7 @@ void ToggleMine::setState(int newState)
   }
 }
 
-std::vector<float> ToggleMine::getState(bool minimalState) const
+std::vector<Real> ToggleMine::getState(bool minimalState) const
 {
   auto baseState = Entity::getState(minimalState);
   return baseState;
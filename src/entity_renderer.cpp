@@ -3,6 +3,8 @@
 #include "entities/exit_door.hpp"
 #include "entities/door_regular.hpp"
 #include "entities/drone_base.hpp"
+#include "entities/drone_zap.hpp"
+#include "entities/mini_drone.hpp"
 #include "entities/laser.hpp"
 #include <cmath>
 
@@ -67,7 +69,7 @@ void EntityRenderer::update()
       if (!entity->isActive())
         continue;
 
-      addEntityToCircles(entity.get(), adjust);
+      addEntityToCircles(entity, adjust);
     }
   }
 }
@@ -79,16 +81,25 @@ void EntityRenderer::addEntityToCircles(const Entity *entity, float adjust)
 
   // Determine radius based on entity type
   float radius = DEFAULT_RADIUS * adjust;
-  if (auto gold = dynamic_cast<const Gold *>(entity))
-    radius = gold->RADIUS * adjust;
-  else if (auto exit = dynamic_cast<const ExitDoor *>(entity))
-    radius = exit->RADIUS * adjust;
-  else if (auto door = dynamic_cast<const DoorRegular *>(entity))
-    radius = door->RADIUS * adjust;
-  else if (auto drone = dynamic_cast<const DroneBase *>(entity))
-    radius = drone->RADIUS * adjust;
-  else if (auto laser = dynamic_cast<const Laser *>(entity))
-    radius = laser->RADIUS * adjust;
+  switch (entity->getEntityType())
+  {
+  case Gold::ENTITY_TYPE:
+    radius = Gold::RADIUS * adjust;
+    break;
+  case ExitDoor::ENTITY_TYPE:
+    radius = ExitDoor::RADIUS * adjust;
+    break;
+  case DoorRegular::ENTITY_TYPE:
+    radius = DoorRegular::RADIUS * adjust;
+    break;
+  case DroneZap::ENTITY_TYPE:
+  case MiniDrone::ENTITY_TYPE:
+    radius = DroneBase::RADIUS * adjust;
+    break;
+  case Laser::ENTITY_TYPE:
+    radius = Laser::RADIUS * adjust;
+    break;
+  }
 
   // Get entity color
   sf::Color color = ENTITY_COLORS.at(entity->getEntityType());
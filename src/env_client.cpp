@@ -0,0 +1,180 @@
+#include "env_client.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace
+{
+  // How long to sleep before checking that the server is still there
+  constexpr int POLL_MS = 100;
+
+  const ShmEnv::Dimensions &checkedDimensions(const ShmEnv::SharedMemory &memory)
+  {
+    const auto *header = reinterpret_cast<const ShmEnv::Header *>(memory.data());
+    if (memory.size() < sizeof(ShmEnv::Header) || header->magic.load(std::memory_order_acquire) != ShmEnv::MAGIC)
+    {
+      throw std::runtime_error("Shared memory segment is not a running environment server");
+    }
+    if (header->version != ShmEnv::VERSION)
+    {
+      throw std::runtime_error("Environment server speaks another protocol version");
+    }
+    if (memory.size() < ShmEnv::Layout(header->dims).size())
+    {
+      throw std::runtime_error("Environment server segment is truncated");
+    }
+    return header->dims;
+  }
+}
+
+EnvClient::EnvClient(const std::string &name)
+    : memory(std::make_unique<ShmEnv::SharedMemory>(name)),
+      layout(checkedDimensions(*memory), memory->data())
+{
+  uint32_t pid = getpid();
+  for (uint32_t i = 0; i < layout.getDimensions().slotCount && slot < 0; ++i)
+  {
+    uint32_t free = 0;
+    if (layout.slot(i).owner.compare_exchange_strong(free, pid))
+    {
+      slot = i;
+    }
+  }
+  if (slot < 0)
+  {
+    throw std::runtime_error("All slots of the environment server are taken");
+  }
+
+  // Let requests left by the slot's previous client finish first
+  nextRequest = nextResult = layout.slot(slot).requestSeq.load(std::memory_order_acquire);
+  try
+  {
+    waitForResponse(nextRequest);
+  }
+  catch (...)
+  {
+    layout.slot(slot).owner.store(0, std::memory_order_release);
+    throw;
+  }
+}
+
+EnvClient::~EnvClient()
+{
+  try
+  {
+    while (getPending() > 0)
+    {
+      wait();
+    }
+  }
+  catch (const std::exception &)
+  {
+    // Failed requests and a stopped server do not matter anymore
+  }
+  layout.slot(slot).owner.store(0, std::memory_order_release);
+}
+
+void EnvClient::loadMap(const std::vector<uint8_t> &mapData, int index)
+{
+  checkNothingPending("loadMap");
+  if (mapData.size() > layout.getDimensions().maxMapSize)
+  {
+    throw std::invalid_argument("Level data larger than the environment server's map area");
+  }
+
+  std::copy(mapData.begin(), mapData.end(), layout.mapData(slot));
+  prepare(ShmEnv::Command::LoadMap, index).mapSize = mapData.size();
+  submit();
+  wait();
+}
+
+EnvClient::Result EnvClient::reset(int index)
+{
+  checkNothingPending("reset");
+  prepare(ShmEnv::Command::Reset, index);
+  submit();
+  return wait();
+}
+
+EnvClient::Result EnvClient::step(const int32_t *actions)
+{
+  checkNothingPending("step");
+  stepAsync(actions);
+  return wait();
+}
+
+void EnvClient::stepAsync(const int32_t *actions)
+{
+  prepare(ShmEnv::Command::Step, -1);
+  std::copy(actions, actions + 2 * size(), layout.actions(slot, nextRequest));
+  submit();
+}
+
+EnvClient::Result EnvClient::wait()
+{
+  if (getPending() == 0)
+  {
+    throw std::logic_error("EnvClient::wait called without a request in flight");
+  }
+
+  uint32_t seq = nextResult++;
+  waitForResponse(seq + 1);
+  const auto &request = layout.request(slot, seq);
+  if (request.failed)
+  {
+    throw std::runtime_error(request.error);
+  }
+  return {layout.observations(slot, seq), layout.rewards(slot, seq), layout.dones(slot, seq)};
+}
+
+ShmEnv::Request &EnvClient::prepare(ShmEnv::Command command, int index)
+{
+  if (getPending() >= getRingDepth())
+  {
+    throw std::logic_error("EnvClient already has ringDepth requests in flight");
+  }
+
+  auto &request = layout.request(slot, nextRequest);
+  request.command = command;
+  request.index = index;
+  request.mapSize = 0;
+  return request;
+}
+
+void EnvClient::submit()
+{
+  auto &state = layout.slot(slot);
+  state.requestSeq.store(++nextRequest, std::memory_order_release);
+  ShmEnv::futexWakeAll(state.requestSeq);
+}
+
+void EnvClient::checkNothingPending(const char *what) const
+{
+  if (getPending() > 0)
+  {
+    throw std::logic_error(std::string("EnvClient::") + what + " called with requests in flight");
+  }
+}
+
+void EnvClient::waitForResponse(uint32_t seq)
+{
+  const auto &header = layout.header();
+  const auto &state = layout.slot(slot);
+  while (true)
+  {
+    // Sequence numbers wrap around, so compare their difference
+    uint32_t response = state.responseSeq.load(std::memory_order_acquire);
+    if (static_cast<int32_t>(response - seq) >= 0)
+    {
+      return;
+    }
+    if (header.stopping.load(std::memory_order_acquire) || !ShmEnv::isProcessAlive(header.serverPid))
+    {
+      throw std::runtime_error("Environment server stopped");
+    }
+    ShmEnv::waitForChange(state.responseSeq, response, POLL_MS);
+  }
+}
\ No newline at end of file
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "shm_env.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Actor side of an EnvServer: claims a free slot of the server's segment and
+// drives its simulations by writing requests straight into shared memory.
+// The results are read in place, so nothing is copied or serialized beyond
+// what the caller does with them. An EnvClient is used by one thread at a time.
+class EnvClient
+{
+public:
+  // Results of a request, in the layout VecSimulation::step() writes. They
+  // point into the request's ring entry, which is reused ringDepth requests later.
+  struct Result
+  {
+    const float *observations;
+    const float *rewards;
+    const uint8_t *dones;
+  };
+
+  // Throws std::runtime_error if there is no such server or all its slots are taken
+  explicit EnvClient(const std::string &name);
+  ~EnvClient();
+
+  EnvClient(const EnvClient &) = delete;
+  EnvClient &operator=(const EnvClient &) = delete;
+
+  int size() const { return layout.getDimensions().envsPerSlot; }
+  int getObservationSize() const { return layout.getDimensions().observationSize; }
+  int getRingDepth() const { return layout.getDimensions().ringDepth; }
+  int getSlot() const { return slot; }
+
+  // Load a level into one simulation of the slot, or into all of them (index -1)
+  void loadMap(const std::vector<uint8_t> &mapData, int index = -1);
+  Result reset(int index = -1);
+
+  // Step every simulation of the slot with size() rows of (horizontal input,
+  // jump input). stepAsync posts the step and returns at once; up to
+  // ringDepth requests can be in flight, and wait returns the oldest one's
+  // results. Requests that fail on the server throw std::runtime_error.
+  Result step(const int32_t *actions);
+  void stepAsync(const int32_t *actions);
+  Result wait();
+  int getPending() const { return nextRequest - nextResult; }
+
+private:
+  ShmEnv::Request &prepare(ShmEnv::Command command, int index);
+  void submit();
+  void checkNothingPending(const char *what) const;
+  void waitForResponse(uint32_t seq);
+
+  std::unique_ptr<ShmEnv::SharedMemory> memory;
+  ShmEnv::Layout layout;
+  int slot = -1;
+  uint32_t nextRequest = 0;
+  uint32_t nextResult = 0;
+};
\ No newline at end of file
@@ -0,0 +1,148 @@
+#include "env_server.hpp"
+#include "observation.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include <unistd.h>
+
+namespace
+{
+  // How long a slot thread sleeps before checking for shutdown and dead clients
+  constexpr int POLL_MS = 100;
+
+  ShmEnv::Dimensions makeDimensions(const EnvServerOptions &options)
+  {
+    if (options.slots < 1 || options.envsPerSlot < 1 || options.ringDepth < 1 || options.maxMapSize < 1)
+    {
+      throw std::invalid_argument("EnvServer needs at least one slot, simulation, ring entry and map byte");
+    }
+    return {static_cast<uint32_t>(options.slots),
+            static_cast<uint32_t>(options.envsPerSlot),
+            static_cast<uint32_t>(options.ringDepth),
+            static_cast<uint32_t>(Observation::maxSize(options.onlyExitAndSwitch)),
+            static_cast<uint32_t>(options.maxMapSize)};
+  }
+}
+
+EnvServer::EnvServer(const std::string &name, const SimConfig &simConfig, const EnvServerOptions &options)
+    : layout(makeDimensions(options))
+{
+  memory = std::make_unique<ShmEnv::SharedMemory>(name, layout.size());
+  layout = ShmEnv::Layout(layout.getDimensions(), memory->data());
+
+  const auto &dims = layout.getDimensions();
+  auto *header = new (&layout.header()) ShmEnv::Header();
+  header->version = ShmEnv::VERSION;
+  header->serverPid = getpid();
+  header->dims = dims;
+  for (uint32_t slot = 0; slot < dims.slotCount; ++slot)
+  {
+    new (&layout.slot(slot)) ShmEnv::Slot();
+    vecs.push_back(std::make_unique<VecSimulation>(dims.envsPerSlot, simConfig, options.onlyExitAndSwitch, options.rewards));
+  }
+
+  for (uint32_t slot = 0; slot < dims.slotCount; ++slot)
+  {
+    threads.emplace_back(&EnvServer::serveSlot, this, slot);
+  }
+  header->magic.store(ShmEnv::MAGIC, std::memory_order_release);
+}
+
+EnvServer::~EnvServer()
+{
+  stop();
+}
+
+void EnvServer::stop()
+{
+  auto &header = layout.header();
+  header.stopping.store(1, std::memory_order_release);
+  for (uint32_t slot = 0; slot < layout.getDimensions().slotCount; ++slot)
+  {
+    // Slot threads sleep on requestSeq, clients on responseSeq
+    ShmEnv::futexWakeAll(layout.slot(slot).requestSeq);
+    ShmEnv::futexWakeAll(layout.slot(slot).responseSeq);
+  }
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+  threads.clear();
+}
+
+void EnvServer::serveSlot(int slot)
+{
+  auto &header = layout.header();
+  auto &state = layout.slot(slot);
+  VecSimulation &vec = *vecs[slot];
+  uint32_t seq = state.responseSeq.load(std::memory_order_relaxed);
+  while (!header.stopping.load(std::memory_order_acquire))
+  {
+    if (!ShmEnv::waitForChange(state.requestSeq, seq, POLL_MS))
+    {
+      uint32_t owner = state.owner.load(std::memory_order_relaxed);
+      if (owner && !ShmEnv::isProcessAlive(owner))
+      {
+        state.owner.compare_exchange_strong(owner, 0);
+      }
+      continue;
+    }
+
+    // Run every request posted so far, in order
+    uint32_t requested = state.requestSeq.load(std::memory_order_acquire);
+    while (seq != requested)
+    {
+      runRequest(slot, seq, vec);
+      state.responseSeq.store(++seq, std::memory_order_release);
+      ShmEnv::futexWakeAll(state.responseSeq);
+    }
+  }
+}
+
+void EnvServer::runRequest(int slot, uint32_t seq, VecSimulation &vec)
+{
+  auto &request = layout.request(slot, seq);
+  float *observations = layout.observations(slot, seq);
+  float *rewards = layout.rewards(slot, seq);
+  uint8_t *dones = layout.dones(slot, seq);
+  request.failed = 0;
+  try
+  {
+    switch (request.command)
+    {
+    case ShmEnv::Command::Step:
+      vec.step(layout.actions(slot, seq), observations, rewards, dones);
+      return;
+    case ShmEnv::Command::Reset:
+      request.index < 0 ? vec.reset() : vec.reset(request.index);
+      break;
+    case ShmEnv::Command::LoadMap:
+    {
+      if (request.mapSize > layout.getDimensions().maxMapSize)
+      {
+        throw std::invalid_argument("Level data larger than the server's map area");
+      }
+      const uint8_t *mapData = layout.mapData(slot);
+      std::vector<uint8_t> map(mapData, mapData + request.mapSize);
+      request.index < 0 ? vec.loadMap(map) : vec.loadMap(request.index, map);
+      break;
+    }
+    default:
+      throw std::invalid_argument("Unknown environment server command");
+    }
+
+    // Reset and LoadMap answer with the current observations
+    vec.writeObservations(observations);
+    std::fill(rewards, rewards + vec.size(), 0.0f);
+    std::fill(dones, dones + vec.size(), 0);
+  }
+  catch (const std::exception &e)
+  {
+    request.failed = 1;
+    std::strncpy(request.error, e.what(), ShmEnv::ERROR_SIZE - 1);
+    request.error[ShmEnv::ERROR_SIZE - 1] = '\0';
+  }
+}
\ No newline at end of file
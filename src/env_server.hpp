@@ -0,0 +1,52 @@
+#pragma once
+
+#include "shm_env.hpp"
+#include "sim_config.hpp"
+#include "vec_simulation.hpp"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct EnvServerOptions
+{
+  int slots = 8;          // Clients served at once
+  int envsPerSlot = 16;   // Simulations stepped per client request
+  int ringDepth = 2;      // Requests a client can have in flight
+  int maxMapSize = 65536; // Bytes of level data a client can load
+  bool onlyExitAndSwitch = false;
+  VecSimulation::Rewards rewards;
+};
+
+// Hosts the simulations of many actor processes and steps them on request
+// through a ShmEnv segment, so that actors do not link the simulator and
+// exchange observations without serialization. Every slot of the segment has
+// its own VecSimulation and a thread serving it, so clients run in parallel.
+// Clients whose process died give their slot back automatically.
+class EnvServer
+{
+public:
+  // Creates the segment and starts serving. Throws if a live server already
+  // uses a segment of that name; one left behind by a killed server is replaced.
+  EnvServer(const std::string &name, const SimConfig &simConfig, const EnvServerOptions &options);
+  ~EnvServer();
+
+  EnvServer(const EnvServer &) = delete;
+  EnvServer &operator=(const EnvServer &) = delete;
+
+  // Tell the clients the server is going away and join the slot threads
+  void stop();
+
+  const ShmEnv::Dimensions &getDimensions() const { return layout.getDimensions(); }
+  size_t getSegmentSize() const { return memory->size(); }
+
+private:
+  void serveSlot(int slot);
+  void runRequest(int slot, uint32_t seq, VecSimulation &vec);
+
+  std::unique_ptr<ShmEnv::SharedMemory> memory;
+  ShmEnv::Layout layout;
+  std::vector<std::unique_ptr<VecSimulation>> vecs;
+  std::vector<std::thread> threads;
+};
\ No newline at end of file
@@ -0,0 +1,91 @@
+// Environment server: hosts simulations for actor processes, which connect
+// with EnvClient (or NPlayShmClient from Python) under the same name.
+//
+// usage: nclone-env-server [--name N] [--slots N] [--envs N] [--ring-depth N]
+//                          [--max-map-size N] [--only-exit-and-switch]
+// Runs until SIGINT or SIGTERM, then removes its shared memory segment.
+
+#include "env_server.hpp"
+
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <string>
+
+#include <pthread.h>
+
+int main(int argc, char **argv)
+{
+  std::string name = "nclone-env";
+  EnvServerOptions options;
+  for (int i = 1; i < argc; ++i)
+  {
+    const char *value = i + 1 < argc ? argv[i + 1] : nullptr;
+    if (std::strcmp(argv[i], "--only-exit-and-switch") == 0)
+    {
+      options.onlyExitAndSwitch = true;
+      continue;
+    }
+    if (!value)
+    {
+      std::fprintf(stderr, "Missing value for %s\n", argv[i]);
+      return 2;
+    }
+    if (std::strcmp(argv[i], "--name") == 0)
+    {
+      name = value;
+    }
+    else if (std::strcmp(argv[i], "--slots") == 0)
+    {
+      options.slots = std::atoi(value);
+    }
+    else if (std::strcmp(argv[i], "--envs") == 0)
+    {
+      options.envsPerSlot = std::atoi(value);
+    }
+    else if (std::strcmp(argv[i], "--ring-depth") == 0)
+    {
+      options.ringDepth = std::atoi(value);
+    }
+    else if (std::strcmp(argv[i], "--max-map-size") == 0)
+    {
+      options.maxMapSize = std::atoi(value);
+    }
+    else
+    {
+      std::fprintf(stderr, "Unknown option %s\n", argv[i]);
+      return 2;
+    }
+    ++i;
+  }
+
+  // Block the shutdown signals in every thread, and wait for them here
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  try
+  {
+    // Headless, so the ninja animation is not needed. Outlives the server.
+    SimConfig simConfig(false, false, 1.0f, false, false);
+    EnvServer server(name, simConfig, options);
+    const auto &dims = server.getDimensions();
+    std::printf("Serving %u slots of %u simulations on %s (%zu bytes, ring depth %u)\n",
+                dims.slotCount, dims.envsPerSlot, name.c_str(), server.getSegmentSize(), dims.ringDepth);
+    std::fflush(stdout);
+
+    int signal = 0;
+    sigwait(&signals, &signal);
+    server.stop();
+  }
+  catch (const std::exception &e)
+  {
+    std::fprintf(stderr, "%s\n", e.what());
+    return 1;
+  }
+  return 0;
+}
\ No newline at end of file
@@ -2,45 +2,47 @@
 #include "simulation.hpp"
 #include "physics/physics.hpp"
 #include "entities/entity.hpp"
+#include <cstring>
 #include <filesystem>
 #include <unordered_map>
 #include <random>
 
 // Initialize static members
-std::vector<std::array<std::pair<float, float>, 13>> Ninja::cachedNinjaAnimation;
 const std::unordered_map<int, Ninja::DanceRange> Ninja::DANCE_DIC = {
     {0, {104, 104}}, {1, {106, 225}}, {2, {226, 345}}, {3, {346, 465}}, {4, {466, 585}}, {5, {586, 705}}, {6, {706, 825}}, {7, {826, 945}}, {8, {946, 1065}}, {9, {1066, 1185}}, {10, {1186, 1305}}, {11, {1306, 1485}}, {12, {1486, 1605}}, {13, {1606, 1664}}, {14, {1665, 1731}}, {15, {1732, 1810}}, {16, {1811, 1852}}, {17, {1853, 1946}}, {18, {1947, 2004}}, {19, {2005, 2156}}, {20, {2157, 2241}}, {21, {2242, 2295}}};
 
-void Ninja::loadNinjaAnimation()
+const std::vector<std::array<std::pair<Real, Real>, 13>> &Ninja::loadNinjaAnimation()
 {
-  if (!cachedNinjaAnimation.empty())
+  // Loaded once and shared read-only by every ninja; the static initializer is thread safe
+  static const auto cachedNinjaAnimation = []
   {
-    return;
-  }
-
-  std::ifstream file(ANIM_DATA_FILE, std::ios::binary);
-  if (!file)
-  {
-    return;
-  }
+    std::vector<std::array<std::pair<Real, Real>, 13>> animation;
+    std::ifstream file(ANIM_DATA_FILE, std::ios::binary);
+    if (!file)
+    {
+      return animation;
+    }
 
-  uint32_t frames;
-  file.read(reinterpret_cast<char *>(&frames), sizeof(frames));
+    uint32_t frames;
+    file.read(reinterpret_cast<char *>(&frames), sizeof(frames));
 
-  cachedNinjaAnimation.resize(frames);
-  for (uint32_t i = 0; i < frames; ++i)
-  {
-    for (int j = 0; j < 13; ++j)
+    animation.resize(frames);
+    for (uint32_t i = 0; i < frames; ++i)
     {
-      double x, y;
-      file.read(reinterpret_cast<char *>(&x), sizeof(x));
-      file.read(reinterpret_cast<char *>(&y), sizeof(y));
-      cachedNinjaAnimation[i][j] = {static_cast<float>(x), static_cast<float>(y)};
+      for (int j = 0; j < 13; ++j)
+      {
+        double x, y;
+        file.read(reinterpret_cast<char *>(&x), sizeof(x));
+        file.read(reinterpret_cast<char *>(&y), sizeof(y));
+        animation[i][j] = {static_cast<Real>(x), static_cast<Real>(y)};
+      }
     }
-  }
+    return animation;
+  }();
+  return cachedNinjaAnimation;
 }
 
-Ninja::Ninja(float xPos, float yPos)
+Ninja::Ninja(Real xPos, Real yPos)
 {
   xpos = xPos;
   ypos = yPos;
@@ -50,8 +52,7 @@ Ninja::Ninja(float xPos, float yPos)
   ninjaAnimMode = std::filesystem::exists(ANIM_DATA_FILE);
   if (ninjaAnimMode)
   {
-    loadNinjaAnimation();
-    ninjaAnimation = cachedNinjaAnimation;
+    ninjaAnimation = &loadNinjaAnimation();
   }
 }
 
@@ -59,19 +60,19 @@ void Ninja::initializeBones()
 {
   // Initialize bone structure relative positions
   bones = {{
-      {0.0f, 0.0f},     // 0: Center
-      {0.5f, 0.5f},     // 1: Upper right
-      {0.0f, 0.7f},     // 2: Top
-      {-0.5f, 0.5f},    // 3: Upper left
-      {-0.7f, 0.0f},    // 4: Left
-      {-0.5f, -0.5f},   // 5: Lower left
-      {0.0f, -0.7f},    // 6: Bottom
-      {0.5f, -0.5f},    // 7: Lower right
-      {0.7f, 0.0f},     // 8: Right
-      {0.35f, 0.35f},   // 9: Inner upper right
-      {-0.35f, 0.35f},  // 10: Inner upper left
-      {-0.35f, -0.35f}, // 11: Inner lower left
-      {0.35f, -0.35f}   // 12: Inner lower right
+      {Real(0.0), Real(0.0)},     // 0: Center
+      {Real(0.5), Real(0.5)},     // 1: Upper right
+      {Real(0.0), Real(0.7)},     // 2: Top
+      {Real(-0.5), Real(0.5)},    // 3: Upper left
+      {Real(-0.7), Real(0.0)},    // 4: Left
+      {Real(-0.5), Real(-0.5)},   // 5: Lower left
+      {Real(0.0), Real(-0.7)},    // 6: Bottom
+      {Real(0.5), Real(-0.5)},    // 7: Lower right
+      {Real(0.7), Real(0.0)},     // 8: Right
+      {Real(0.35), Real(0.35)},   // 9: Inner upper right
+      {Real(-0.35), Real(0.35)},  // 10: Inner upper left
+      {Real(-0.35), Real(-0.35)}, // 11: Inner lower left
+      {Real(0.35), Real(-0.35)}   // 12: Inner lower right
   }};
   bonesOld = bones;
 }
@@ -93,14 +94,14 @@ void Ninja::preCollision()
   yspeedOld = yspeed;
   floorCount = 0;
   ceilingCount = 0;
-  floorNormalX = 0.0f;
-  floorNormalY = 0.0f;
-  ceilingNormalX = 0.0f;
-  ceilingNormalY = 0.0f;
+  floorNormalX = 0.0;
+  floorNormalY = 0.0;
+  ceilingNormalX = 0.0;
+  ceilingNormalY = 0.0;
   isCrushable = false;
-  xCrush = 0.0f;
-  yCrush = 0.0f;
-  crushLen = 0.0f;
+  xCrush = 0.0;
+  yCrush = 0.0;
+  crushLen = 0.0;
 }
 
 bool Ninja::isValidTarget() const
@@ -138,7 +139,7 @@ void Ninja::win()
   }
 }
 
-void Ninja::kill(int type, float killXpos, float killYpos, float killXspeed, float killYspeed)
+void Ninja::kill(int type, Real killXpos, Real killYpos, Real killXspeed, Real killYspeed)
 {
   if (state < 6)
   {
@@ -168,50 +169,50 @@ void Ninja::floorJump()
   state = 3;
   appliedGravity = GRAVITY_JUMP;
 
-  float jx = 0.0f;
-  float jy = 0.0f;
+  Real jx = 0.0;
+  Real jy = 0.0;
 
-  if (floorNormalizedX == 0.0f)
+  if (floorNormalizedX == 0)
   { // Jump from flat ground
-    jx = 0.0f;
-    jy = -2.0f;
+    jx = 0.0;
+    jy = -2.0;
   }
   else
   { // Slope jump
-    float dx = floorNormalizedX;
-    float dy = floorNormalizedY;
-    if (xspeed * dx >= 0.0f)
+    Real dx = floorNormalizedX;
+    Real dy = floorNormalizedY;
+    if (xspeed * dx >= 0)
     { // Moving downhill
-      if (xspeed * horInput >= 0.0f)
+      if (xspeed * horInput >= 0)
       {
-        jx = 2.0f / 3.0f * dx;
-        jy = 2.0f * dy;
+        jx = Real(2.0) / Real(3.0) * dx;
+        jy = Real(2.0) * dy;
       }
       else
       {
-        jx = 0.0f;
-        jy = -1.4f;
+        jx = 0.0;
+        jy = -1.4;
       }
     }
     else
     { // Moving uphill
-      if (xspeed * horInput > 0.0f)
+      if (xspeed * horInput > 0)
       { // Forward jump
-        jx = 0.0f;
-        jy = -1.4f;
+        jx = 0.0;
+        jy = -1.4;
       }
       else
       { // Perp jump
-        xspeed = 0.0f;
-        jx = 2.0f / 3.0f * dx;
-        jy = 2.0f * dy;
+        xspeed = 0.0;
+        jx = Real(2.0) / Real(3.0) * dx;
+        jy = Real(2.0) * dy;
       }
     }
   }
 
-  if (yspeed > 0.0f)
+  if (yspeed > 0)
   {
-    yspeed = 0.0f;
+    yspeed = 0.0;
   }
   xspeed += jx;
   yspeed += jy;
@@ -222,28 +223,28 @@ void Ninja::floorJump()
 
 void Ninja::wallJump()
 {
-  float jx, jy;
-  if (horInput * wallNormal < 0.0f && state == 5)
+  Real jx, jy;
+  if (horInput * wallNormal < 0 && state == 5)
   { // Slide wall jump
-    jx = 2.0f / 3.0f;
-    jy = -1.0f;
+    jx = Real(2.0) / Real(3.0);
+    jy = -1.0;
   }
   else
   { // Regular wall jump
-    jx = 1.0f;
-    jy = -1.4f;
+    jx = 1.0;
+    jy = -1.4;
   }
 
   state = 3;
   appliedGravity = GRAVITY_JUMP;
 
-  if (xspeed * wallNormal < 0.0f)
+  if (xspeed * wallNormal < 0)
   {
-    xspeed = 0.0f;
+    xspeed = 0.0;
   }
-  if (yspeed > 0.0f)
+  if (yspeed > 0)
   {
-    yspeed = 0.0f;
+    yspeed = 0.0;
   }
 
   xspeed += jx * wallNormal;
@@ -263,14 +264,14 @@ void Ninja::lpJump()
   jumpBuffer = -1;
   launchPadBuffer = -1;
 
-  float boostScalar = 2.0f * std::abs(xlpBoostNormalized) + 2.0f;
-  if (boostScalar == 2.0f)
+  Real boostScalar = Real(2.0) * std::abs(xlpBoostNormalized) + Real(2.0);
+  if (boostScalar == 2)
   {
-    boostScalar = 1.7f; // This was really needed. Thanks Metanet
+    boostScalar = 1.7; // This was really needed. Thanks Metanet
   }
 
-  xspeed += xlpBoostNormalized * boostScalar * 2.0f / 3.0f;
-  yspeed += ylpBoostNormalized * boostScalar * 2.0f / 3.0f;
+  xspeed += xlpBoostNormalized * boostScalar * Real(2.0) / Real(3.0);
+  yspeed += ylpBoostNormalized * boostScalar * Real(2.0) / Real(3.0);
 }
 
 void Ninja::think()
@@ -355,14 +356,14 @@ void Ninja::think()
   // This block deals with the case where the ninja is touching a floor
   if (!airborn)
   {
-    float xspeedNew = xspeed + GROUND_ACCEL * horInput;
+    Real xspeedNew = xspeed + GROUND_ACCEL * horInput;
     if (std::abs(xspeedNew) < MAX_HOR_SPEED)
     {
       xspeed = xspeedNew;
     }
     if (state > 2)
     {
-      if (xspeed * horInput <= 0.0f)
+      if (xspeed * horInput <= 0)
       {
         if (state == 3)
         {
@@ -383,23 +384,23 @@ void Ninja::think()
     { // if not jumping
       if (state == 2)
       {
-        float projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
-        if (horInput * projection * xspeed > 0.0f)
+        Real projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
+        if (horInput * projection * xspeed > 0)
         {
           state = 1;
           return;
         }
-        if (projection < 0.1f && floorNormalizedX == 0.0f)
+        if (projection < Real(0.1) && floorNormalizedX == 0)
         {
           state = 0;
           return;
         }
-        if (yspeed < 0.0f && floorNormalizedX != 0.0f)
+        if (yspeed < 0 && floorNormalizedX != 0)
         {
           // Up slope friction formula
-          float speedScalar = std::sqrt(xspeed * xspeed + yspeed * yspeed);
-          float fricForce = std::abs(xspeed * (1.0f - FRICTION_GROUND) * floorNormalizedY);
-          float fricForce2 = speedScalar - fricForce * floorNormalizedY * floorNormalizedY;
+          Real speedScalar = std::sqrt(xspeed * xspeed + yspeed * yspeed);
+          Real fricForce = std::abs(xspeed * (Real(1.0) - FRICTION_GROUND) * floorNormalizedY);
+          Real fricForce2 = speedScalar - fricForce * floorNormalizedY * floorNormalizedY;
           xspeed = xspeed / speedScalar * fricForce2;
           yspeed = yspeed / speedScalar * fricForce2;
           return;
@@ -409,19 +410,19 @@ void Ninja::think()
       }
       if (state == 1)
       {
-        float projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
-        if (horInput * projection * xspeed > 0.0f)
+        Real projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
+        if (horInput * projection * xspeed > 0)
         {
           // if holding inputs in downhill direction or flat ground
-          if (horInput * floorNormalizedX >= 0.0f)
+          if (horInput * floorNormalizedX >= 0)
           {
             return;
           }
           if (std::abs(xspeedNew) < MAX_HOR_SPEED)
           {
-            float boost = GROUND_ACCEL / 2.0f * horInput;
-            float xboost = boost * floorNormalizedY * floorNormalizedY;
-            float yboost = boost * floorNormalizedY * -floorNormalizedX;
+            Real boost = GROUND_ACCEL / Real(2.0) * horInput;
+            Real xboost = boost * floorNormalizedY * floorNormalizedY;
+            Real yboost = boost * floorNormalizedY * -floorNormalizedX;
             xspeed += xboost;
             yspeed += yboost;
           }
@@ -431,13 +432,13 @@ void Ninja::think()
       }
       else
       { // if you were in state 0
-        if (horInput != 0.0f)
+        if (horInput != 0)
         {
           state = 1;
           return;
         }
-        float projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
-        if (projection < 0.1f)
+        Real projection = std::abs(yspeed * floorNormalizedX - xspeed * floorNormalizedY);
+        if (projection < Real(0.1))
         {
           xspeed *= FRICTION_GROUND_SLOW;
           return;
@@ -453,7 +454,7 @@ void Ninja::think()
   // This block deals with the case where the ninja didn't touch a floor
   else
   {
-    float xspeedNew = xspeed + AIR_ACCEL * horInput;
+    Real xspeedNew = xspeed + AIR_ACCEL * horInput;
     if (std::abs(xspeedNew) < MAX_HOR_SPEED)
     {
       xspeed = xspeedNew;
@@ -502,7 +503,7 @@ void Ninja::think()
     {
       if (state == 5)
       {
-        if (horInput * wallNormal <= 0.0f)
+        if (horInput * wallNormal <= 0)
         {
           yspeed *= FRICTION_WALL;
         }
@@ -513,7 +514,7 @@ void Ninja::think()
       }
       else
       {
-        if (yspeed > 0.0f && horInput * wallNormal < 0.0f)
+        if (yspeed > 0 && horInput * wallNormal < 0)
         {
           if (state == 3)
           {
@@ -533,13 +534,13 @@ void Ninja::updateGraphics()
   if (state == 5)
   {
     animState = 4;
-    tilt = 0.0f;
+    tilt = 0.0;
     facing = -wallNormal;
     animRate = yspeed;
   }
   else if (!airborn && state != 3)
   {
-    tilt = std::atan2(floorNormalizedY, floorNormalizedX) + M_PI / 2.0f;
+    tilt = std::atan2(floorNormalizedY, floorNormalizedX) + M_PI / Real(2.0);
     if (state == 0)
     {
       animState = 0;
@@ -569,19 +570,19 @@ void Ninja::updateGraphics()
     animRate = yspeed;
     if (state == 3)
     {
-      tilt = 0.0f;
+      tilt = 0.0;
     }
     else
     {
-      tilt *= 0.9f;
+      tilt *= 0.9;
     }
   }
 
   if (state != 5)
   {
-    if (std::abs(xspeed) > 0.01f)
+    if (std::abs(xspeed) > Real(0.01))
     {
-      facing = xspeed > 0.0f ? 1 : -1;
+      facing = xspeed > 0 ? 1 : -1;
     }
   }
 
@@ -602,20 +603,20 @@ void Ninja::updateGraphics()
         {
           animFrame = 39;
           runCycle = 162;
-          frameResidual = 0.0f;
+          frameResidual = 0.0;
         }
         else
         {
           animFrame = 12;
           runCycle = 0;
-          frameResidual = 0.0f;
+          frameResidual = 0.0;
         }
       }
       else
       {
         animFrame = 18;
         runCycle = 36;
-        frameResidual = 0.0f;
+        frameResidual = 0.0;
       }
     }
     if (animState == 2)
@@ -659,23 +660,23 @@ void Ninja::updateGraphics()
   }
   if (animState == 1)
   {
-    float newCycle = animRate / 0.15f + frameResidual;
+    Real newCycle = animRate / Real(0.15) + frameResidual;
     frameResidual = newCycle - std::floor(newCycle);
     runCycle = (runCycle + static_cast<int>(std::floor(newCycle))) % 432;
     animFrame = runCycle / 6 + 12;
   }
   if (animState == 3)
   {
-    float rate;
-    if (animRate >= 0.0f)
+    Real rate;
+    if (animRate >= 0)
     {
-      rate = std::sqrt(std::min(animRate * 0.6f, 1.0f));
+      rate = std::sqrt(std::min(animRate * Real(0.6), Real(1.0)));
     }
     else
     {
-      rate = std::max(animRate * 1.5f, -1.0f);
+      rate = std::max(animRate * Real(1.5), Real(-1.0));
     }
-    animFrame = 93 + static_cast<int>(std::floor(9.0f * rate));
+    animFrame = 93 + static_cast<int>(std::floor(Real(9.0) * rate));
   }
   if (animState == 6)
   {
@@ -695,9 +696,7 @@ void Ninja::updateGraphics()
 void Ninja::collideVsObjects(Simulation &sim)
 {
   // Get entities from neighborhood
-  auto entities = Physics::gatherEntitiesFromNeighbourhood(sim, xpos, ypos);
-
-  for (auto *entity : entities)
+  for (auto *entity : sim.getEntityNeighbourhood(xpos, ypos))
   {
     if (entity->isPhysicalCollidable())
     {
@@ -706,13 +705,13 @@ void Ninja::collideVsObjects(Simulation &sim)
       {
         // Get depenetration values from collision result
         // r1 = normal.x, r2 = normal.y, r3 = depenetration length
-        float normalX = collision->getR1();
-        float normalY = collision->getR2().value_or(0.0f);
-        float depenLen = collision->getR3().value_or(0.0f);
+        Real normalX = collision->getR1();
+        Real normalY = collision->getR2().value_or(Real(0.0));
+        Real depenLen = collision->getR3().value_or(Real(0.0));
 
         // Calculate depenetration vector
-        float popX = normalX * depenLen;
-        float popY = normalY * depenLen;
+        Real popX = normalX * depenLen;
+        Real popY = normalY * depenLen;
         xpos += popX;
         ypos += popY;
 
@@ -740,14 +739,14 @@ void Ninja::collideVsObjects(Simulation &sim)
         // Handle one-way platform collisions
         if (entity->getType() == 11)
         {
-          float xspeedNew = (xspeed * normalY - yspeed * normalX) * normalY;
-          float yspeedNew = (xspeed * normalY - yspeed * normalX) * (-normalX);
+          Real xspeedNew = (xspeed * normalY - yspeed * normalX) * normalY;
+          Real yspeedNew = (xspeed * normalY - yspeed * normalX) * (-normalX);
           xspeed = xspeedNew;
           yspeed = yspeedNew;
         }
 
         // Adjust ceiling variables if ninja collides with ceiling (or wall!)
-        if (normalY >= -0.0001f)
+        if (normalY >= -Real(0.0001))
         {
           ceilingCount++;
           ceilingNormalX += normalX;
@@ -767,64 +766,87 @@ void Ninja::collideVsObjects(Simulation &sim)
 void Ninja::collideVsTiles(Simulation &sim)
 {
   // Interpolation routine mainly to prevent from going through walls
-  float dx = xpos - xposOld;
-  float dy = ypos - yposOld;
-  float time = Physics::sweepCircleVsTiles(sim, xposOld, yposOld, dx, dy, RADIUS * 0.5f);
+  Real dx = xpos - xposOld;
+  Real dy = ypos - yposOld;
+  Real time = Physics::sweepCircleVsTiles(sim, xposOld, yposOld, dx, dy, RADIUS * Real(0.5));
   xpos = xposOld + time * dx;
   ypos = yposOld + time * dy;
 
+  // In open air the clearance field shows there is nothing to push against
+  if (Physics::isClearOfTiles(sim, xpos, ypos, RADIUS))
+    return;
+
   // Find the closest point from the ninja, apply depenetration and update speed. Loop 32 times.
+  // Most substeps need at most two queries (push out, then confirm), which read the
+  // segment stores directly. Longer loops gather the active segments around the ninja
+  // with a small margin and reuse them until a push takes it out of the gathered cells.
+  auto &segmentCache = tileSegments.get();
   for (int i = 0; i < 32; i++)
   {
-    auto result = Physics::getSingleClosestPoint(sim, xpos, ypos, RADIUS);
+    std::optional<std::tuple<bool, std::pair<Real, Real>>> result;
+    if (i < 2)
+    {
+      result = Physics::getSingleClosestPoint(sim, xpos, ypos, RADIUS);
+    }
+    else
+    {
+      auto cells = SegmentCache::regionCells(xpos - RADIUS, ypos - RADIUS, xpos + RADIUS, ypos + RADIUS);
+      if (i == 2 || !segmentCache.covers(cells))
+      {
+        segmentCache.gather(sim, SegmentCache::regionCells(xpos - RADIUS - CACHE_MARGIN, ypos - RADIUS - CACHE_MARGIN,
+                                                           xpos + RADIUS + CACHE_MARGIN, ypos + RADIUS + CACHE_MARGIN));
+      }
+      result = Physics::getSingleClosestPoint(segmentCache, cells, xpos, ypos);
+    }
     if (!result)
       break;
 
     const auto &[isBackFacing, closestPoint] = *result;
     const auto &[a, b] = closestPoint;
 
-    float dx = xpos - a;
-    float dy = ypos - b;
+    Real dx = xpos - a;
+    Real dy = ypos - b;
 
-    // Handle corner cases
-    if (std::abs(dx) <= 0.0000001f)
+    // Handle corner cases. The positions come from the double precision
+    // simulator, so only the NCLONE_DOUBLE_PRECISION build matches them exactly.
+    if (std::abs(dx) <= Real(0.0000001))
     {
       dx = 0;
-      if (xpos == 50.51197510492316f || xpos == 49.23232124849253f)
+      if (xpos == Real(50.51197510492316) || xpos == Real(49.23232124849253))
       {
-        dx = -std::pow(2.0f, -47.0f);
+        dx = -std::pow(Real(2.0), Real(-47.0));
       }
-      if (xpos == 49.153536108584795f)
+      if (xpos == Real(49.153536108584795))
       {
-        dx = std::pow(2.0f, -47.0f);
+        dx = std::pow(Real(2.0), Real(-47.0));
       }
     }
 
-    float dist = std::sqrt(dx * dx + dy * dy);
-    float depenLen = RADIUS - dist * (isBackFacing ? -1.0f : 1.0f);
+    Real dist = std::sqrt(dx * dx + dy * dy);
+    Real depenLen = RADIUS - dist * (isBackFacing ? Real(-1.0) : Real(1.0));
 
-    if (dist == 0 || depenLen < 0.0000001f)
+    if (dist == 0 || depenLen < Real(0.0000001))
       return;
 
-    float depenX = dx / dist * depenLen;
-    float depenY = dy / dist * depenLen;
+    Real depenX = dx / dist * depenLen;
+    Real depenY = dy / dist * depenLen;
     xpos += depenX;
     ypos += depenY;
     xCrush += depenX;
     yCrush += depenY;
     crushLen += depenLen;
 
-    float dotProduct = xspeed * dx + yspeed * dy;
+    Real dotProduct = xspeed * dx + yspeed * dy;
     if (dotProduct < 0) // Project velocity onto surface only if moving towards surface
     {
-      float xspeedNew = (xspeed * dy - yspeed * dx) / (dist * dist) * dy;
-      float yspeedNew = (xspeed * dy - yspeed * dx) / (dist * dist) * (-dx);
+      Real xspeedNew = (xspeed * dy - yspeed * dx) / (dist * dist) * dy;
+      Real yspeedNew = (xspeed * dy - yspeed * dx) / (dist * dist) * (-dx);
       xspeed = xspeedNew;
       yspeed = yspeedNew;
     }
 
     // Adjust ceiling variables if ninja collides with ceiling (or wall!)
-    if (dy >= -0.0001f)
+    if (dy >= -Real(0.0001))
     {
       ceilingCount++;
       ceilingNormalX += dx / dist;
@@ -839,18 +861,35 @@ void Ninja::collideVsTiles(Simulation &sim)
   }
 }
 
+// One substep of the tick's collision loop, entities then tiles. Returns false
+// when the pass fired no collision and left the ninja's position and speed
+// bitwise unchanged. The passes read nothing else that a pass without any
+// collision could change, so the remaining passes would repeat this one and
+// can be skipped with the exact same result.
+bool Ninja::collisionPass(Simulation &sim)
+{
+  const std::array<Real, 4> before = {xpos, ypos, xspeed, yspeed};
+  const int contactsBefore = floorCount + ceilingCount;
+
+  collideVsObjects(sim);
+  collideVsTiles(sim);
+
+  const std::array<Real, 4> after = {xpos, ypos, xspeed, yspeed};
+  return floorCount + ceilingCount != contactsBefore || std::memcmp(before.data(), after.data(), sizeof(before)) != 0;
+}
+
 void Ninja::calcNinjaPosition()
 {
-  if (!ninjaAnimMode || ninjaAnimation.empty())
+  if (!ninjaAnimMode || !ninjaAnimation || ninjaAnimation->empty())
   {
     return;
   }
 
   // Create temporary bones array for new positions
-  std::array<std::pair<float, float>, NUM_BONES> newBones;
+  std::array<std::pair<Real, Real>, NUM_BONES> newBones;
 
   // Get bones from animation frame
-  const auto &animFrameBones = ninjaAnimation[animFrame];
+  const auto &animFrameBones = (*ninjaAnimation)[animFrame];
   for (int i = 0; i < NUM_BONES; ++i)
   {
     newBones[i] = animFrameBones[i];
@@ -859,10 +898,10 @@ void Ninja::calcNinjaPosition()
   // Handle running animation interpolation
   if (animState == 1)
   {
-    float interpolation = static_cast<float>(runCycle % 6) / 6.0f;
+    Real interpolation = static_cast<Real>(runCycle % 6) / Real(6.0);
     if (interpolation > 0)
     {
-      const auto &nextBones = ninjaAnimation[(animFrame - 12) % 72 + 12];
+      const auto &nextBones = (*ninjaAnimation)[(animFrame - 12) % 72 + 12];
       for (int i = 0; i < NUM_BONES; ++i)
       {
         newBones[i].first += interpolation * (nextBones[i].first - newBones[i].first);
@@ -875,10 +914,10 @@ void Ninja::calcNinjaPosition()
   for (int i = 0; i < NUM_BONES; ++i)
   {
     newBones[i].first *= facing;
-    float x = newBones[i].first;
-    float y = newBones[i].second;
-    float tcos = std::cos(tilt);
-    float tsin = std::sin(tilt);
+    Real x = newBones[i].first;
+    Real y = newBones[i].second;
+    Real tcos = std::cos(tilt);
+    Real tsin = std::sin(tilt);
     newBones[i].first = x * tcos - y * tsin;
     newBones[i].second = x * tsin + y * tcos;
   }
@@ -892,9 +931,8 @@ void Ninja::postCollision(Simulation &sim)
 {
   // Perform LOGICAL collisions between the ninja and nearby entities.
   // Also check if the ninja can interact with the walls of entities when applicable.
-  float wallNormalSum = 0.0f;
-  auto entities = Physics::gatherEntitiesFromNeighbourhood(sim, xpos, ypos);
-  for (auto *entity : entities)
+  Real wallNormalSum = 0.0;
+  for (auto *entity : sim.getEntityNeighbourhood(xpos, ypos))
   {
     if (entity->isLogicalCollidable())
     {
@@ -903,18 +941,18 @@ void Ninja::postCollision(Simulation &sim)
       {
         if (entity->getType() == 10)
         { // If collision with launch pad, update speed and position
-          float normalX = collisionResult->getR1();
-          float normalY = collisionResult->getR2().value_or(0.0f);
-          float depenLen = collisionResult->getR3().value_or(0.0f);
-          float xboost = normalX * depenLen * 2.0f / 3.0f;
-          float yboost = normalY * depenLen * 2.0f / 3.0f;
+          Real normalX = collisionResult->getR1();
+          Real normalY = collisionResult->getR2().value_or(Real(0.0));
+          Real depenLen = collisionResult->getR3().value_or(Real(0.0));
+          Real xboost = normalX * depenLen * Real(2.0) / Real(3.0);
+          Real yboost = normalY * depenLen * Real(2.0) / Real(3.0);
           xpos += xboost;
           ypos += yboost;
           xspeed = xboost;
           yspeed = yboost;
           floorCount = 0;
           floorBuffer = -1;
-          float boostScalar = std::sqrt(xboost * xboost + yboost * yboost);
+          Real boostScalar = std::sqrt(xboost * xboost + yboost * yboost);
           xlpBoostNormalized = xboost / boostScalar;
           ylpBoostNormalized = yboost / boostScalar;
           launchPadBuffer = 0;
@@ -933,30 +971,28 @@ void Ninja::postCollision(Simulation &sim)
   }
 
   // Check if the ninja can interact with walls from nearby tile segments
-  float rad = RADIUS + 0.1f;
-  auto segments = sim.getSegmentsInRegion(xpos - rad, ypos - rad, xpos + rad, ypos + rad);
-  for (const auto &segment : segments)
-  {
+  Real rad = RADIUS + Real(0.1);
+  sim.forEachSegmentInRegion(xpos - rad, ypos - rad, xpos + rad, ypos + rad, [&](const auto &segment)
+                             {
     bool valid;
-    float a, b;
-    std::tie(valid, a, b) = segment->getClosestPoint(xpos, ypos);
+    Real a, b;
+    std::tie(valid, a, b) = segment.getClosestPoint(xpos, ypos);
     if (!valid)
-      continue;
+      return;
 
-    float dx = xpos - a;
-    float dy = ypos - b;
-    float dist = std::sqrt(dx * dx + dy * dy);
-    if (std::abs(dy) < 0.00001f && dist > 0.0f && dist <= rad)
+    Real dx = xpos - a;
+    Real dy = ypos - b;
+    Real dist = std::sqrt(dx * dx + dy * dy);
+    if (std::abs(dy) < Real(0.00001) && dist > 0 && dist <= rad)
     {
       wallNormalSum += dx / dist;
-    }
-  }
+    } });
 
   // Check if airborn or walled
   airbornOld = airborn;
   airborn = true;
   walled = false;
-  if (wallNormalSum != 0.0f)
+  if (wallNormalSum != 0)
   {
     walled = true;
     wallNormal = wallNormalSum / std::abs(wallNormalSum);
@@ -966,11 +1002,11 @@ void Ninja::postCollision(Simulation &sim)
   if (floorCount > 0)
   {
     airborn = false;
-    float floorScalar = std::sqrt(floorNormalX * floorNormalX + floorNormalY * floorNormalY);
-    if (floorScalar == 0.0f)
+    Real floorScalar = std::sqrt(floorNormalX * floorNormalX + floorNormalY * floorNormalY);
+    if (floorScalar == 0)
     {
-      floorNormalizedX = 0.0f;
-      floorNormalizedY = -1.0f;
+      floorNormalizedX = 0.0;
+      floorNormalizedY = -1.0;
     }
     else
     {
@@ -979,12 +1015,12 @@ void Ninja::postCollision(Simulation &sim)
     }
     if (state != 8 && airbornOld)
     { // Check if died from floor impact
-      float impactVel = -(floorNormalizedX * xspeedOld + floorNormalizedY * yspeedOld);
-      if (impactVel > MAX_SURVIVABLE_IMPACT - 4.0f / 3.0f * std::abs(floorNormalizedY))
+      Real impactVel = -(floorNormalizedX * xspeedOld + floorNormalizedY * yspeedOld);
+      if (impactVel > MAX_SURVIVABLE_IMPACT - Real(4.0) / Real(3.0) * std::abs(floorNormalizedY))
       {
         xspeed = xspeedOld;
         yspeed = yspeedOld;
-        kill(1, xpos, ypos, xspeed * 0.5f, yspeed * 0.5f);
+        kill(1, xpos, ypos, xspeed * Real(0.5), yspeed * Real(0.5));
       }
     }
   }
@@ -992,11 +1028,11 @@ void Ninja::postCollision(Simulation &sim)
   // Calculate the combined ceiling normalized normal vector if the ninja has touched any ceiling
   if (ceilingCount > 0)
   {
-    float ceilingScalar = std::sqrt(ceilingNormalX * ceilingNormalX + ceilingNormalY * ceilingNormalY);
-    if (ceilingScalar == 0.0f)
+    Real ceilingScalar = std::sqrt(ceilingNormalX * ceilingNormalX + ceilingNormalY * ceilingNormalY);
+    if (ceilingScalar == 0)
     {
-      ceilingNormalizedX = 0.0f;
-      ceilingNormalizedY = 1.0f;
+      ceilingNormalizedX = 0.0;
+      ceilingNormalizedY = 1.0;
     }
     else
     {
@@ -1005,22 +1041,22 @@ void Ninja::postCollision(Simulation &sim)
     }
     if (state != 8)
     { // Check if died from ceiling impact
-      float impactVel = -(ceilingNormalizedX * xspeedOld + ceilingNormalizedY * yspeedOld);
-      if (impactVel > MAX_SURVIVABLE_IMPACT - 4.0f / 3.0f * std::abs(ceilingNormalizedY))
+      Real impactVel = -(ceilingNormalizedX * xspeedOld + ceilingNormalizedY * yspeedOld);
+      if (impactVel > MAX_SURVIVABLE_IMPACT - Real(4.0) / Real(3.0) * std::abs(ceilingNormalizedY))
       {
         xspeed = xspeedOld;
         yspeed = yspeedOld;
-        kill(1, xpos, ypos, xspeed * 0.5f, yspeed * 0.5f);
+        kill(1, xpos, ypos, xspeed * Real(0.5), yspeed * Real(0.5));
       }
     }
   }
 
   // Check if ninja died from crushing
-  if (isCrushable && crushLen > 0.0f)
+  if (isCrushable && crushLen > 0)
   {
     if (std::sqrt(xCrush * xCrush + yCrush * yCrush) / crushLen < MIN_SURVIVABLE_CRUSHING)
     {
-      kill(2, xpos, ypos, 0.0f, 0.0f);
+      kill(2, xpos, ypos, Real(0.0), Real(0.0));
     }
   }
 }
\ No newline at end of file
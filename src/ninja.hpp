@@ -8,6 +8,8 @@
 #include <fstream>
 #include <unordered_map>
 #include "physics/physics.hpp"
+#include "physics/segment_cache.hpp"
+#include "utils.hpp"
 
 class Simulation;
 
@@ -15,39 +17,40 @@ class Ninja
 {
 public:
   // Physics constants
-  static constexpr float GRAVITY_FALL = 0.06666666666666665f;
-  static constexpr float GRAVITY_JUMP = 0.01111111111111111f;
-  static constexpr float GROUND_ACCEL = 0.06666666666666665f;
-  static constexpr float AIR_ACCEL = 0.04444444444444444f;
-  static constexpr float DRAG_REGULAR = 0.9933221725495059f;         // 0.99^(2/3)
-  static constexpr float DRAG_SLOW = 0.8617738760127536f;            // 0.80^(2/3)
-  static constexpr float FRICTION_GROUND = 0.9459290248857720f;      // 0.92^(2/3)
-  static constexpr float FRICTION_GROUND_SLOW = 0.8617738760127536f; // 0.80^(2/3)
-  static constexpr float FRICTION_WALL = 0.9113380468927672f;        // 0.87^(2/3)
-  static constexpr float MAX_HOR_SPEED = 3.333333333333333f;
+  static constexpr Real GRAVITY_FALL = 0.06666666666666665;
+  static constexpr Real GRAVITY_JUMP = 0.01111111111111111;
+  static constexpr Real GROUND_ACCEL = 0.06666666666666665;
+  static constexpr Real AIR_ACCEL = 0.04444444444444444;
+  static constexpr Real DRAG_REGULAR = 0.9933221725495059;         // 0.99^(2/3)
+  static constexpr Real DRAG_SLOW = 0.8617738760127536;            // 0.80^(2/3)
+  static constexpr Real FRICTION_GROUND = 0.9459290248857720;      // 0.92^(2/3)
+  static constexpr Real FRICTION_GROUND_SLOW = 0.8617738760127536; // 0.80^(2/3)
+  static constexpr Real FRICTION_WALL = 0.9113380468927672;        // 0.87^(2/3)
+  static constexpr Real MAX_HOR_SPEED = 3.333333333333333;
   static constexpr int MAX_JUMP_DURATION = 45;
-  static constexpr float MAX_SURVIVABLE_IMPACT = 6.0f;
-  static constexpr float MIN_SURVIVABLE_CRUSHING = 0.05f;
-  static constexpr float RADIUS = 10.0f;
+  static constexpr Real MAX_SURVIVABLE_IMPACT = 6.0;
+  static constexpr Real MIN_SURVIVABLE_CRUSHING = 0.05;
+  static constexpr Real RADIUS = 10.0;
+  static constexpr Real CACHE_MARGIN = 2.0; // Slack around the depenetration segment cache
 
   // Position and velocity
-  float xpos = 0.0f;
-  float ypos = 0.0f;
-  float xspeed = 0.0f;
-  float yspeed = 0.0f;
-  float xposOld = 0.0f;
-  float yposOld = 0.0f;
-  float xspeedOld = 0.0f;
-  float yspeedOld = 0.0f;
-  float deathXpos = 0.0f;
-  float deathYpos = 0.0f;
-  float deathXspeed = 0.0f;
-  float deathYspeed = 0.0f;
+  Real xpos = 0.0;
+  Real ypos = 0.0;
+  Real xspeed = 0.0;
+  Real yspeed = 0.0;
+  Real xposOld = 0.0;
+  Real yposOld = 0.0;
+  Real xspeedOld = 0.0;
+  Real yspeedOld = 0.0;
+  Real deathXpos = 0.0;
+  Real deathYpos = 0.0;
+  Real deathXspeed = 0.0;
+  Real deathYspeed = 0.0;
 
   // Physics state
-  float appliedGravity = GRAVITY_FALL;
-  float appliedDrag = DRAG_REGULAR;
-  float appliedFriction = FRICTION_GROUND;
+  Real appliedGravity = GRAVITY_FALL;
+  Real appliedDrag = DRAG_REGULAR;
+  Real appliedFriction = FRICTION_GROUND;
   int state = 0; // 0:Immobile, 1:Running, 2:Ground sliding, 3:Jumping, 4:Falling, 5:Wall sliding
   bool airborn = false;
   bool airbornOld = false;
@@ -62,35 +65,35 @@ public:
   int launchPadBuffer = -1;
 
   // Floor and wall normals
-  float floorNormalizedX = 0.0f;
-  float floorNormalizedY = -1.0f;
-  float ceilingNormalizedX = 0.0f;
-  float ceilingNormalizedY = 1.0f;
-  float wallNormal = 0.0f;
-  float xlpBoostNormalized = 0.0f;
-  float ylpBoostNormalized = 0.0f;
+  Real floorNormalizedX = 0.0;
+  Real floorNormalizedY = -1.0;
+  Real ceilingNormalizedX = 0.0;
+  Real ceilingNormalizedY = 1.0;
+  Real wallNormal = 0.0;
+  Real xlpBoostNormalized = 0.0;
+  Real ylpBoostNormalized = 0.0;
 
   // Animation state
   int animState = 0;
   int facing = 1;
-  float tilt = 0.0f;
-  float animRate = 0.0f;
+  Real tilt = 0.0;
+  Real animRate = 0.0;
   int animFrame = 11;
-  float frameResidual = 0.0f;
+  Real frameResidual = 0.0;
   int runCycle = 0;
   int danceId = 0;
 
   // Collision state
   int floorCount = 0;
   int ceilingCount = 0;
-  float floorNormalX = 0.0f;
-  float floorNormalY = 0.0f;
-  float ceilingNormalX = 0.0f;
-  float ceilingNormalY = 0.0f;
+  Real floorNormalX = 0.0;
+  Real floorNormalY = 0.0;
+  Real ceilingNormalX = 0.0;
+  Real ceilingNormalY = 0.0;
   bool isCrushable = false;
-  float xCrush = 0.0f;
-  float yCrush = 0.0f;
-  float crushLen = 0.0f;
+  Real xCrush = 0.0;
+  Real yCrush = 0.0;
+  Real crushLen = 0.0;
 
   // Game state
   int goldCollected = 0;
@@ -105,21 +108,20 @@ public:
 
   // Bone structure
   static constexpr int NUM_BONES = 13;
-  std::array<std::pair<float, float>, NUM_BONES> bones;
-  std::array<std::pair<float, float>, NUM_BONES> bonesOld;
+  std::array<std::pair<Real, Real>, NUM_BONES> bones;
+  std::array<std::pair<Real, Real>, NUM_BONES> bonesOld;
 
   // Position and speed logs
-  std::vector<std::tuple<int, float, float>> posLog;
-  std::vector<std::tuple<int, float, float>> speedLog;
-  std::vector<float> xposLog;
-  std::vector<float> yposLog;
+  std::vector<std::tuple<int, Real, Real>> posLog;
+  std::vector<std::tuple<int, Real, Real>> speedLog;
+  std::vector<Real> xposLog;
+  std::vector<Real> yposLog;
 
   // Animation data
   static constexpr const char *ANIM_DATA_FILE = "../anim_data_line_new.txt.bin";
-  static std::vector<std::array<std::pair<float, float>, 13>> cachedNinjaAnimation;
-  static void loadNinjaAnimation();
+  static const std::vector<std::array<std::pair<Real, Real>, 13>> &loadNinjaAnimation();
   bool ninjaAnimMode = false;
-  std::vector<std::array<std::pair<float, float>, 13>> ninjaAnimation;
+  const std::vector<std::array<std::pair<Real, Real>, 13>> *ninjaAnimation = nullptr; // Shared by every ninja
   void calcNinjaPosition();
 
   // Dance parameters
@@ -133,11 +135,12 @@ public:
   static const std::unordered_map<int, DanceRange> DANCE_DIC;
 
   // Methods
-  Ninja(float xPos = 0.0f, float yPos = 0.0f);
+  Ninja(Real xPos = 0.0, Real yPos = 0.0);
   void integrate();
   void preCollision();
   void collideVsObjects(Simulation &sim);
   void collideVsTiles(Simulation &sim);
+  bool collisionPass(Simulation &sim);
   void postCollision(Simulation &sim);
   void floorJump();
   void wallJump();
@@ -146,7 +149,7 @@ public:
   void thinkAwaitingDeath();
   void updateGraphics();
   void win();
-  void kill(int type, float xpos, float ypos, float xspeed, float yspeed);
+  void kill(int type, Real xpos, Real ypos, Real xspeed, Real yspeed);
   bool isValidTarget() const;
   void log(int frame);
   bool hasWon() const;
@@ -158,9 +161,12 @@ public:
   void setAnimFrame(int frame) { animFrame = frame; }
   void setAnimState(int state) { animState = state; }
   int getState() const { return state; }
-  float getXPos() const { return xpos; }
-  float getYPos() const { return ypos; }
+  Real getXPos() const { return xpos; }
+  Real getYPos() const { return ypos; }
 
 private:
   void initializeBones();
+
+  // Reused by the collision passes so gathering neighbours and segments does not allocate
+  Scratch<SegmentCache> tileSegments;
 };
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include "observation.hpp"
+#include "ninja.hpp"
+#include "entities/entity.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace
+{
+  // Constants from Python implementation
+  const int MAX_ATTRIBUTES = 4;
+  const std::unordered_map<int, int> MAX_COUNTS = {
+      {1, 128}, // Toggle Mine
+      {2, 128}, // Gold
+      {3, 1},   // Exit
+      {5, 32},  // Door Regular
+      {6, 32},  // Door Locked
+      {8, 32},  // Door Trap
+      {10, 32}, // Launch Pad
+      {11, 32}, // One Way Platform
+      {14, 32}, // Drone Zap
+      {17, 32}, // Bounce Block
+      {20, 32}, // Thwump
+      {24, 32}, // Boost Pad
+      {25, 32}, // Death Ball
+      {26, 32}, // Mini Drone
+      {28, 32}  // Shove Thwump
+  };
+}
+
+int Observation::maxEntityStateSize(bool onlyExitAndSwitch)
+{
+  if (onlyExitAndSwitch)
+  {
+    return 2;
+  }
+
+  int size = 0;
+  for (const auto &[entityType, maxCount] : MAX_COUNTS)
+  {
+    size += 1 + maxCount * MAX_ATTRIBUTES;
+  }
+  return size;
+}
+
+void Observation::writeNinjaState(const Simulation &sim, float *out)
+{
+  const Ninja *ninja = sim.getNinja();
+
+  // Match Python implementation order
+  out[0] = ninja->xpos / 1056.0f;                                // Position normalized by screen width
+  out[1] = ninja->ypos / 600.0f;                                 // Position normalized by screen height
+  out[2] = (ninja->xspeed / ninja->MAX_HOR_SPEED + 1.0f) / 2.0f; // Speed normalized to [0,1]
+  out[3] = (ninja->yspeed / ninja->MAX_HOR_SPEED + 1.0f) / 2.0f;
+  out[4] = ninja->airborn ? 1.0f : 0.0f;
+  out[5] = ninja->walled ? 1.0f : 0.0f;
+  out[6] = static_cast<float>(ninja->jumpDuration) / ninja->MAX_JUMP_DURATION;
+  out[7] = (ninja->appliedGravity - ninja->GRAVITY_JUMP) / (ninja->GRAVITY_FALL - ninja->GRAVITY_JUMP);
+  out[8] = (ninja->appliedDrag - ninja->DRAG_SLOW) / (ninja->DRAG_REGULAR - ninja->DRAG_SLOW);
+  out[9] = (ninja->appliedFriction - ninja->FRICTION_WALL) / (ninja->FRICTION_GROUND - ninja->FRICTION_WALL);
+}
+
+int Observation::writeEntityStates(const Simulation &sim, bool onlyExitAndSwitch, float *out)
+{
+  float *begin = out;
+
+  if (onlyExitAndSwitch)
+  {
+    // Just the exit door and exit switch active states
+    for (int entityType : {3, 4})
+    {
+      const auto &entities = sim.getEntitiesByType(entityType);
+      if (!entities.empty())
+      {
+        *out++ = entities[0]->isActive() ? 1.0f : 0.0f;
+      }
+    }
+    return out - begin;
+  }
+
+  // Process each entity type
+  for (const auto &[entityType, maxCount] : MAX_COUNTS)
+  {
+    const auto &entities = sim.getEntitiesByType(entityType);
+    *out++ = static_cast<float>(entities.size()) / maxCount;
+
+    // Process each entity up to maxCount, padding attributes and missing entities with zeros
+    std::fill(out, out + maxCount * MAX_ATTRIBUTES, 0.0f);
+    for (int i = 0; i < maxCount && i < static_cast<int>(entities.size()); i++)
+    {
+      auto entityState = entities[i]->getState(false);
+      std::copy_n(entityState.begin(), std::min<size_t>(entityState.size(), MAX_ATTRIBUTES), out + i * MAX_ATTRIBUTES);
+    }
+    out += maxCount * MAX_ATTRIBUTES;
+  }
+  return out - begin;
+}
\ No newline at end of file
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "simulation.hpp"
+
+// Normalized state of a simulation as fed to agents, in the order of the
+// Python implementation: the ninja's state, then the entity states. Values are
+// written to caller memory, so SimWrapper can return them as vectors and
+// VecSimulation can write them straight into its observation rows.
+class Observation
+{
+public:
+  static constexpr int NINJA_STATE_SIZE = 10;
+
+  // Upper bound of writeEntityStates, and the exact count without onlyExitAndSwitch
+  static int maxEntityStateSize(bool onlyExitAndSwitch);
+  static int maxSize(bool onlyExitAndSwitch) { return NINJA_STATE_SIZE + maxEntityStateSize(onlyExitAndSwitch); }
+
+  static void writeNinjaState(const Simulation &sim, float *out);
+
+  // With onlyExitAndSwitch, only the active flags of the exit door and its
+  // switch, for those the level has. Returns the number of values written.
+  static int writeEntityStates(const Simulation &sim, bool onlyExitAndSwitch, float *out);
+};
\ No newline at end of file
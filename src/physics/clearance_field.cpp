@@ -0,0 +1,123 @@
+#include "clearance_field.hpp"
+#include "segment_cache.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+  // Slack for the float rounding of the collision routines the bounds stand in for
+  constexpr double MARGIN = 0.01;
+
+  struct Square
+  {
+    double x1, y1, x2, y2;
+    double xcenter, ycenter;
+    double halfDiagonal;
+  };
+
+  // Each bound is a lower bound of the distance from any point of the square
+  // to the segment, or 0 if the segment might be back facing from some of them
+
+  double boundLinear(const Square &square, const GridSegmentLinear &segment)
+  {
+    double x1 = segment.getX1(), y1 = segment.getY1();
+    double px = segment.getX2() - x1, py = segment.getY2() - y1;
+    double lengthSq = px * px + py * py;
+
+    // The sign test of GridSegmentLinear::getClosestPoint is linear in the
+    // position, so its minimum over the square is reached at a corner
+    double minCross = std::min({(square.y1 - y1) * px - (square.x1 - x1) * py,
+                                (square.y1 - y1) * px - (square.x2 - x1) * py,
+                                (square.y2 - y1) * px - (square.x1 - x1) * py,
+                                (square.y2 - y1) * px - (square.x2 - x1) * py});
+    if (minCross < MARGIN * std::sqrt(lengthSq))
+    {
+      return 0.0;
+    }
+
+    double dx = square.xcenter - x1, dy = square.ycenter - y1;
+    double u = lengthSq > 0 ? std::clamp((dx * px + dy * py) / lengthSq, 0.0, 1.0) : 0.0;
+    double ex = dx - u * px, ey = dy - u * py;
+    return std::sqrt(ex * ex + ey * ey) - square.halfDiagonal;
+  }
+
+  double boundCircular(const Square &square, const GridSegmentCircular &segment)
+  {
+    auto [a, b] = segment.getCenter();
+    auto [hor, ver] = segment.getQuadrant();
+    double radius = segment.getRadius();
+
+    // Back facing is only reported inside the arc's quadrant, on the inner
+    // side of convex arcs and the outer side of concave ones
+    bool inQuadrant = (hor > 0 ? square.x2 > a - MARGIN : square.x1 < a + MARGIN) &&
+                      (ver > 0 ? square.y2 > b - MARGIN : square.y1 < b + MARGIN);
+    if (inQuadrant)
+    {
+      double nearX = std::clamp<double>(a, square.x1, square.x2) - a;
+      double nearY = std::clamp<double>(b, square.y1, square.y2) - b;
+      double farX = std::max(std::abs(square.x1 - a), std::abs(square.x2 - a));
+      double farY = std::max(std::abs(square.y1 - b), std::abs(square.y2 - b));
+      bool crossesSide = segment.isConvex() ? nearX * nearX + nearY * nearY < (radius + MARGIN) * (radius + MARGIN)
+                                            : farX * farX + farY * farY > (radius - MARGIN) * (radius - MARGIN);
+      if (crossesSide)
+      {
+        return 0.0;
+      }
+    }
+
+    // Any point of the arc or of its extremities lies on the full circle
+    double dx = square.xcenter - a, dy = square.ycenter - b;
+    return std::abs(std::sqrt(dx * dx + dy * dy) - radius) - square.halfDiagonal;
+  }
+}
+
+ClearanceField::ClearanceField(const SegmentStore &segments)
+    : segments(segments)
+{
+}
+
+void ClearanceField::buildCell(int xcell, int ycell) const
+{
+  std::lock_guard<std::mutex> lock(buildMutex);
+  int cell = ycell * 44 + xcell;
+  if (built[cell].load(std::memory_order_relaxed))
+  {
+    return;
+  }
+
+  for (int y = ycell * SQUARES_PER_CELL; y < (ycell + 1) * SQUARES_PER_CELL; ++y)
+  {
+    for (int x = xcell * SQUARES_PER_CELL; x < (xcell + 1) * SQUARES_PER_CELL; ++x)
+    {
+      Square square;
+      square.x1 = x * SQUARE_SIZE;
+      square.y1 = y * SQUARE_SIZE;
+      square.x2 = square.x1 + SQUARE_SIZE;
+      square.y2 = square.y1 + SQUARE_SIZE;
+      square.xcenter = square.x1 + SQUARE_SIZE * 0.5;
+      square.ycenter = square.y1 + SQUARE_SIZE * 0.5;
+      square.halfDiagonal = SQUARE_SIZE * std::sqrt(0.5);
+
+      // Every cell a query of radius up to MAX_RADIUS from this square can visit.
+      // Segments of any other cell are at least MAX_RADIUS away.
+      auto cells = SegmentCache::regionCells(square.x1 - MAX_RADIUS, square.y1 - MAX_RADIUS,
+                                             square.x2 + MAX_RADIUS, square.y2 + MAX_RADIUS);
+
+      double nearest = MAX_RADIUS;
+      for (int cx = cells.x1; cx <= cells.x2 && nearest > 0; ++cx)
+      {
+        for (int cy = cells.y1; cy <= cells.y2 && nearest > 0; ++cy)
+        {
+          segments.forEachLinearInCell({cx, cy}, [&](const GridSegmentLinear &segment)
+                                       { nearest = std::min(nearest, boundLinear(square, segment)); });
+          segments.forEachCircularInCell({cx, cy}, [&](const GridSegmentCircular &segment)
+                                         { nearest = std::min(nearest, boundCircular(square, segment)); });
+        }
+      }
+
+      clearance[{x, y}] = static_cast<Real>(std::max(0.0, nearest - MARGIN));
+    }
+  }
+
+  built[cell].store(true, std::memory_order_release);
+}
\ No newline at end of file
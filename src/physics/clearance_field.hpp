@@ -0,0 +1,63 @@
+#pragma once
+
+#include "segment_store.hpp"
+#include "../utils.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+
+// Conservative distance field of the static tile segments, sampled on small
+// squares covering the map. It lets collision routines prove that a circle is
+// clear of every tile segment without visiting them.
+//
+// For every point of a square, getClearance() is a lower bound of the distance
+// to any tile segment, capped at MAX_RADIUS. It is 0 instead wherever a segment
+// that a query of radius up to MAX_RADIUS could visit might be back facing from
+// somewhere in the square, since such a segment can win a closest point query
+// even when it is far away. It is also 0 outside the map. Door segments are
+// not included.
+//
+// Evaluating every square of a level costs far more than loading it, and most
+// of them are never reached, so the squares of a cell are filled the first
+// time one of them is sampled. Sampling is thread safe, as a compiled map is
+// shared by all the simulations playing it.
+class ClearanceField
+{
+public:
+  static constexpr int SQUARE_SIZE = 6;
+  static constexpr int SQUARES_PER_CELL = 24 / SQUARE_SIZE;
+  static constexpr int WIDTH = 44 * SQUARES_PER_CELL;
+  static constexpr int HEIGHT = 25 * SQUARES_PER_CELL;
+  static constexpr Real MAX_RADIUS = 12.0;
+
+  // The segments must be built before the first sample and outlive the field
+  explicit ClearanceField(const SegmentStore &segments);
+
+  Real getClearance(Real xpos, Real ypos) const
+  {
+    // Written to also reject NaN. Inside the map, truncation is the floor.
+    if (!(xpos >= 0 && ypos >= 0 && xpos < WIDTH * SQUARE_SIZE && ypos < HEIGHT * SQUARE_SIZE))
+    {
+      return 0.0;
+    }
+    int x = std::min(static_cast<int>(xpos / SQUARE_SIZE), WIDTH - 1);
+    int y = std::min(static_cast<int>(ypos / SQUARE_SIZE), HEIGHT - 1);
+
+    int cell = y / SQUARES_PER_CELL * 44 + x / SQUARES_PER_CELL;
+    if (!built[cell].load(std::memory_order_acquire))
+    {
+      buildCell(x / SQUARES_PER_CELL, y / SQUARES_PER_CELL);
+    }
+    return clearance[{x, y}];
+  }
+
+private:
+  void buildCell(int xcell, int ycell) const;
+
+  const SegmentStore &segments;
+  mutable std::mutex buildMutex;
+  mutable std::array<std::atomic<bool>, 44 * 25> built{};
+  mutable Grid<Real, WIDTH, HEIGHT> clearance;
+};
\ No newline at end of file
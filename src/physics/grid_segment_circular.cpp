@@ -2,9 +2,8 @@
 #include "../physics/physics.hpp"
 #include <cmath>
 
-GridSegmentCircular::GridSegmentCircular(std::pair<float, float> center, std::pair<int, int> quadrant, bool convex, float radius)
-    : Segment(center.first, center.second, center.first + radius * quadrant.first, center.second + radius * quadrant.second),
-      xpos(center.first), ypos(center.second),
+GridSegmentCircular::GridSegmentCircular(std::pair<Real, Real> center, std::pair<int, int> quadrant, bool convex, Real radius)
+    : xpos(center.first), ypos(center.second),
       hor(quadrant.first), ver(quadrant.second),
       radius(radius), active(true), convex(convex)
 {
@@ -13,20 +12,20 @@ GridSegmentCircular::GridSegmentCircular(std::pair<float, float> center, std::pa
   pVer = std::make_pair(xpos, ypos + radius * ver);
 }
 
-std::tuple<bool, float, float> GridSegmentCircular::getClosestPoint(float xposIn, float yposIn) const
+std::tuple<bool, Real, Real> GridSegmentCircular::getClosestPoint(Real xposIn, Real yposIn) const
 {
-  float dx = xposIn - xpos;
-  float dy = yposIn - ypos;
+  Real dx = xposIn - xpos;
+  Real dy = yposIn - ypos;
   bool isBackFacing = false;
 
   // This is true if position is closer from arc than its edges
   if (dx * hor > 0 && dy * ver > 0)
   {
-    float dist = std::sqrt(dx * dx + dy * dy);
+    Real dist = std::sqrt(dx * dx + dy * dy);
     if (dist > 0)
     {
-      float a = xpos + radius * dx / dist;
-      float b = ypos + radius * dy / dist;
+      Real a = xpos + radius * dx / dist;
+      Real b = ypos + radius * dy / dist;
       isBackFacing = dist < radius ? convex : !convex;
       return std::make_tuple(isBackFacing, a, b);
     }
@@ -43,11 +42,11 @@ std::tuple<bool, float, float> GridSegmentCircular::getClosestPoint(float xposIn
   }
 }
 
-float GridSegmentCircular::intersectWithRay(float xposIn, float yposIn, float dx, float dy, float radiusIn) const
+Real GridSegmentCircular::intersectWithRay(Real xposIn, Real yposIn, Real dx, Real dy, Real radiusIn) const
 {
-  float time1 = Physics::getTimeOfIntersectionCircleVsCircle(xposIn, yposIn, dx, dy, pHor.first, pHor.second, radiusIn);
-  float time2 = Physics::getTimeOfIntersectionCircleVsCircle(xposIn, yposIn, dx, dy, pVer.first, pVer.second, radiusIn);
-  float time3 = Physics::getTimeOfIntersectionCircleVsArc(xposIn, yposIn, dx, dy, xpos, ypos, hor, ver, radius, radiusIn);
+  Real time1 = Physics::getTimeOfIntersectionCircleVsCircle(xposIn, yposIn, dx, dy, pHor.first, pHor.second, radiusIn);
+  Real time2 = Physics::getTimeOfIntersectionCircleVsCircle(xposIn, yposIn, dx, dy, pVer.first, pVer.second, radiusIn);
+  Real time3 = Physics::getTimeOfIntersectionCircleVsArc(xposIn, yposIn, dx, dy, xpos, ypos, hor, ver, radius, radiusIn);
 
   return std::min({time1, time2, time3});
 }
\ No newline at end of file
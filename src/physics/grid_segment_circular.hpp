@@ -1,30 +1,35 @@
 #pragma once
 
-#include "segment.hpp"
+#include "../real.hpp"
+
+#include <tuple>
 #include <utility>
 #include <cmath>
 
-class GridSegmentCircular : public Segment
+// Plain quarter-circle segment, see GridSegmentLinear.
+class GridSegmentCircular
 {
 public:
-  GridSegmentCircular(std::pair<float, float> center, std::pair<int, int> quadrant, bool convex, float radius = 24.0f);
+  GridSegmentCircular(std::pair<Real, Real> center, std::pair<int, int> quadrant, bool convex, Real radius = 24.0);
 
-  std::tuple<bool, float, float> getClosestPoint(float xpos, float ypos) const override;
-  float intersectWithRay(float xpos, float ypos, float dx, float dy, float radius) const override;
+  std::tuple<bool, Real, Real> getClosestPoint(Real xpos, Real ypos) const;
+  Real intersectWithRay(Real xpos, Real ypos, Real dx, Real dy, Real radius) const;
 
-  // Implement virtual getters
-  const char *getType() const override { return type; }
-  float getRadius() const override { return radius; }
-  float getStartAngle() const override { return std::atan2(ver, hor); }
-  float getEndAngle() const override { return std::atan2(ver, hor) + M_PI / 2; }
+  Real getRadius() const { return radius; }
+  std::pair<Real, Real> getCenter() const { return {xpos, ypos}; }
+  std::pair<int, int> getQuadrant() const { return {hor, ver}; }
+  bool isConvex() const { return convex; }
+  Real getStartAngle() const { return std::atan2(ver, hor); }
+  Real getEndAngle() const { return std::atan2(ver, hor) + M_PI / 2; }
+  bool isActive() const { return active; }
+  void setActive(bool isActive) { active = isActive; }
 
 private:
-  float xpos, ypos;             // Center position
-  int hor, ver;                 // Quadrant direction
-  float radius;                 // Radius of the quarter-circle
-  std::pair<float, float> pHor; // Horizontal extremity
-  std::pair<float, float> pVer; // Vertical extremity
-  bool active;                  // Whether the segment is currently active
-  const char *type = "circular";
-  bool convex; // Whether the quarter-circle is convex or concave
+  Real xpos, ypos;            // Center position
+  int hor, ver;               // Quadrant direction
+  Real radius;                // Radius of the quarter-circle
+  std::pair<Real, Real> pHor; // Horizontal extremity
+  std::pair<Real, Real> pVer; // Vertical extremity
+  bool active;                // Whether the segment is currently active
+  bool convex;                // Whether the quarter-circle is convex or concave
 };
\ No newline at end of file
@@ -1,23 +1,30 @@
 #pragma once
 
-#include "segment.hpp"
+#include "../real.hpp"
+
+#include <tuple>
 #include <utility>
 
-class GridSegmentLinear : public Segment
+// Plain linear segment. Kept trivially copyable so cells can store their
+// segments contiguously and the collision kernels can call it without dispatch.
+class GridSegmentLinear
 {
 public:
-  GridSegmentLinear(std::pair<float, float> p1, std::pair<float, float> p2, bool oriented = true);
+  GridSegmentLinear(std::pair<Real, Real> p1, std::pair<Real, Real> p2, bool oriented = true);
 
-  std::tuple<bool, float, float> getClosestPoint(float xpos, float ypos) const override;
-  float intersectWithRay(float xpos, float ypos, float dx, float dy, float radius) const override;
+  std::tuple<bool, Real, Real> getClosestPoint(Real xpos, Real ypos) const;
+  Real intersectWithRay(Real xpos, Real ypos, Real dx, Real dy, Real radius) const;
 
-  // Implement virtual getters
-  const char *getType() const override { return type; }
+  Real getX1() const { return x1; }
+  Real getY1() const { return y1; }
+  Real getX2() const { return x2; }
+  Real getY2() const { return y2; }
+  bool isActive() const { return active; }
+  void setActive(bool isActive) { active = isActive; }
 
 private:
-  float x1, y1;  // First endpoint
-  float x2, y2;  // Second endpoint
+  Real x1, y1;   // First endpoint
+  Real x2, y2;   // Second endpoint
   bool oriented; // Whether the segment has an inner/outer side
   bool active;   // Whether the segment is currently active
-  const char *type = "linear";
 };
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include "linear_sweep.hpp"
+#include "physics.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+// The lanes hold floats, so the double precision build always takes the scalar path
+#if defined(NCLONE_DOUBLE_PRECISION)
+#elif defined(__AVX__)
+#include <immintrin.h>
+#define NCLONE_SWEEP_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define NCLONE_SWEEP_SSE2
+#endif
+
+namespace
+{
+#if defined(NCLONE_SWEEP_AVX)
+  struct Lanes
+  {
+    using V = __m256;
+    static constexpr int WIDTH = 8;
+
+    static V set1(float f) { return _mm256_set1_ps(f); }
+    static V load(const float *p) { return _mm256_loadu_ps(p); }
+    static V laneIndex() { return _mm256_setr_ps(0, 1, 2, 3, 4, 5, 6, 7); }
+    static V add(V a, V b) { return _mm256_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm256_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm256_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm256_div_ps(a, b); }
+    static V sqrt(V a) { return _mm256_sqrt_ps(a); }
+    static V min(V a, V b) { return _mm256_min_ps(a, b); }
+    static V abs(V a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+    static V gt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+    static V ge(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); }
+    static V lt(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+    static V le(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+    static V eq(V a, V b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+    static V both(V a, V b) { return _mm256_and_ps(a, b); }
+    static V butNot(V a, V b) { return _mm256_andnot_ps(b, a); }
+    static V select(V mask, V a, V b) { return _mm256_blendv_ps(b, a, mask); }
+    static void store(float *p, V a) { _mm256_storeu_ps(p, a); }
+  };
+#elif defined(NCLONE_SWEEP_SSE2)
+  struct Lanes
+  {
+    using V = __m128;
+    static constexpr int WIDTH = 4;
+
+    static V set1(float f) { return _mm_set1_ps(f); }
+    static V load(const float *p) { return _mm_loadu_ps(p); }
+    static V laneIndex() { return _mm_setr_ps(0, 1, 2, 3); }
+    static V add(V a, V b) { return _mm_add_ps(a, b); }
+    static V sub(V a, V b) { return _mm_sub_ps(a, b); }
+    static V mul(V a, V b) { return _mm_mul_ps(a, b); }
+    static V div(V a, V b) { return _mm_div_ps(a, b); }
+    static V sqrt(V a) { return _mm_sqrt_ps(a); }
+    static V min(V a, V b) { return _mm_min_ps(a, b); }
+    static V abs(V a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+    static V gt(V a, V b) { return _mm_cmpgt_ps(a, b); }
+    static V ge(V a, V b) { return _mm_cmpge_ps(a, b); }
+    static V lt(V a, V b) { return _mm_cmplt_ps(a, b); }
+    static V le(V a, V b) { return _mm_cmple_ps(a, b); }
+    static V eq(V a, V b) { return _mm_cmpeq_ps(a, b); }
+    static V both(V a, V b) { return _mm_and_ps(a, b); }
+    static V butNot(V a, V b) { return _mm_andnot_ps(b, a); }
+    static V select(V mask, V a, V b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+    static void store(float *p, V a) { _mm_storeu_ps(p, a); }
+  };
+#endif
+
+#if defined(NCLONE_SWEEP_AVX) || defined(NCLONE_SWEEP_SSE2)
+  using V = Lanes::V;
+
+  // Lane-wise Physics::getTimeOfIntersectionCircleVsCircle
+  inline V circleVsPoint(V xpos, V ypos, V vx, V vy, V velSq, V radiusSq, V a, V b)
+  {
+    const V zero = Lanes::set1(0.0f);
+    const V one = Lanes::set1(1.0f);
+
+    V dx = Lanes::sub(xpos, a);
+    V dy = Lanes::sub(ypos, b);
+    V distSq = Lanes::add(Lanes::mul(dx, dx), Lanes::mul(dy, dy));
+    V dotProd = Lanes::add(Lanes::mul(dx, vx), Lanes::mul(dy, vy));
+    V gap = Lanes::sub(distSq, radiusSq);
+
+    V radicand = Lanes::sub(Lanes::mul(dotProd, dotProd), Lanes::mul(velSq, gap));
+    V hit = Lanes::both(Lanes::both(Lanes::gt(velSq, Lanes::set1(0.0001f)), Lanes::lt(dotProd, zero)),
+                        Lanes::ge(radicand, zero));
+    V time = Lanes::div(Lanes::sub(Lanes::sub(zero, dotProd), Lanes::sqrt(radicand)), velSq);
+
+    return Lanes::select(Lanes::gt(gap, zero), Lanes::select(hit, time, one), zero);
+  }
+
+  // Lane-wise Physics::getTimeOfIntersectionCircleVsLineseg
+  inline V circleVsLineseg(V xpos, V ypos, V dx, V dy, V radius, V a1, V b1, V a2, V b2)
+  {
+    const V zero = Lanes::set1(0.0f);
+    const V one = Lanes::set1(1.0f);
+
+    V wx = Lanes::sub(a2, a1);
+    V wy = Lanes::sub(b2, b1);
+    V segLen = Lanes::sqrt(Lanes::add(Lanes::mul(wx, wx), Lanes::mul(wy, wy)));
+
+    V nx = Lanes::div(wx, segLen);
+    V ny = Lanes::div(wy, segLen);
+    V px = Lanes::sub(xpos, a1);
+    V py = Lanes::sub(ypos, b1);
+    V normalProj = Lanes::sub(Lanes::mul(px, ny), Lanes::mul(py, nx));
+    V horProj = Lanes::add(Lanes::mul(px, nx), Lanes::mul(py, ny));
+    V absNormalProj = Lanes::abs(normalProj);
+
+    // Circle outside the segment's band, moving towards it
+    V dir = Lanes::sub(Lanes::mul(dx, ny), Lanes::mul(dy, nx));
+    V approaching = Lanes::lt(Lanes::mul(dir, normalProj), zero);
+    V time = Lanes::min(Lanes::div(Lanes::sub(absNormalProj, radius), Lanes::abs(dir)), one);
+    V horProj2 = Lanes::add(horProj, Lanes::mul(time, Lanes::add(Lanes::mul(dx, nx), Lanes::mul(dy, ny))));
+    V landsOnSegment = Lanes::both(Lanes::le(zero, horProj2), Lanes::le(horProj2, segLen));
+    V outside = Lanes::ge(absNormalProj, radius);
+    V sweepHit = Lanes::both(Lanes::both(outside, approaching), landsOnSegment);
+
+    // Circle already overlapping the segment
+    V overSegment = Lanes::both(Lanes::le(zero, horProj), Lanes::le(horProj, segLen));
+    V overlapping = Lanes::butNot(overSegment, outside);
+
+    V result = Lanes::select(sweepHit, time, Lanes::select(overlapping, zero, one));
+    return Lanes::select(Lanes::eq(segLen, zero), one, result);
+  }
+
+  float sweepVector(const SegmentStore::LinearCoords &coords, uint32_t begin, uint32_t end,
+                    float xposScalar, float yposScalar, float dxScalar, float dyScalar, float radiusScalar)
+  {
+    const V xpos = Lanes::set1(xposScalar);
+    const V ypos = Lanes::set1(yposScalar);
+    const V dx = Lanes::set1(dxScalar);
+    const V dy = Lanes::set1(dyScalar);
+    const V radius = Lanes::set1(radiusScalar);
+    const V velSq = Lanes::set1(dxScalar * dxScalar + dyScalar * dyScalar);
+    const V radiusSq = Lanes::set1(radiusScalar * radiusScalar);
+    const V one = Lanes::set1(1.0f);
+    const V laneIndex = Lanes::laneIndex();
+
+    V shortest = one;
+    for (uint32_t i = begin; i < end; i += Lanes::WIDTH)
+    {
+      V a1 = Lanes::load(&coords.x1[i]);
+      V b1 = Lanes::load(&coords.y1[i]);
+      V a2 = Lanes::load(&coords.x2[i]);
+      V b2 = Lanes::load(&coords.y2[i]);
+
+      V time = Lanes::min(circleVsPoint(xpos, ypos, dx, dy, velSq, radiusSq, a1, b1),
+                          circleVsPoint(xpos, ypos, dx, dy, velSq, radiusSq, a2, b2));
+      time = Lanes::min(time, circleVsLineseg(xpos, ypos, dx, dy, radius, a1, b1, a2, b2));
+
+      // Lanes past the end of the run read padding or the next cells' segments
+      V inRun = Lanes::lt(laneIndex, Lanes::set1(static_cast<float>(end - i)));
+      shortest = Lanes::min(shortest, Lanes::select(inRun, time, one));
+    }
+
+    float lanes[Lanes::WIDTH];
+    Lanes::store(lanes, shortest);
+    return *std::min_element(lanes, lanes + Lanes::WIDTH);
+  }
+#endif
+}
+
+Real LinearSweep::sweep(const SegmentStore::LinearCoords &coords, uint32_t begin, uint32_t end,
+                        Real xpos, Real ypos, Real dx, Real dy, Real radius)
+{
+#if defined(NCLONE_SWEEP_AVX) || defined(NCLONE_SWEEP_SSE2)
+  Real shortestTime = sweepVector(coords, begin, end, xpos, ypos, dx, dy, radius);
+#ifdef NCLONE_VERIFY_SIMD
+  Real reference = sweepScalar(coords, begin, end, xpos, ypos, dx, dy, radius);
+  if (std::memcmp(&shortestTime, &reference, sizeof(Real)) != 0)
+  {
+    throw std::logic_error("Vectorized tile sweep differs from the scalar path");
+  }
+#endif
+  return shortestTime;
+#else
+  return sweepScalar(coords, begin, end, xpos, ypos, dx, dy, radius);
+#endif
+}
+
+Real LinearSweep::sweepScalar(const SegmentStore::LinearCoords &coords, uint32_t begin, uint32_t end,
+                              Real xpos, Real ypos, Real dx, Real dy, Real radius)
+{
+  Real shortestTime = 1.0;
+  for (uint32_t i = begin; i < end; ++i)
+  {
+    Real time1 = Physics::getTimeOfIntersectionCircleVsCircle(xpos, ypos, dx, dy, coords.x1[i], coords.y1[i], radius);
+    Real time2 = Physics::getTimeOfIntersectionCircleVsCircle(xpos, ypos, dx, dy, coords.x2[i], coords.y2[i], radius);
+    Real time3 = Physics::getTimeOfIntersectionCircleVsLineseg(xpos, ypos, dx, dy,
+                                                               coords.x1[i], coords.y1[i], coords.x2[i], coords.y2[i], radius);
+    shortestTime = std::min({time1, time2, time3, shortestTime});
+  }
+  return shortestTime;
+}
\ No newline at end of file
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "segment_store.hpp"
+#include <cstdint>
+
+// Narrow phase of Physics::sweepCircleVsTiles for a run of tile linears:
+// the earliest time at which a moving circle touches any of the segments or
+// their endpoints, or 1 if it touches none.
+//
+// The vectorized path evaluates 4 segments per step with SSE2, or 8 in builds
+// for AVX (the NCLONE_AVX CMake option), with the same operations in the same order as the scalar
+// getTimeOfIntersection routines, so both paths give bitwise identical times
+// as long as the compiler does not contract multiplies and adds into FMAs.
+// Building with NCLONE_VERIFY_SIMD checks every result against the scalar
+// path and throws std::logic_error on the first difference.
+class LinearSweep
+{
+public:
+  static Real sweep(const SegmentStore::LinearCoords &coords, uint32_t begin, uint32_t end,
+                    Real xpos, Real ypos, Real dx, Real dy, Real radius);
+
+  // Reference path, one segment at a time through the Physics routines
+  static Real sweepScalar(const SegmentStore::LinearCoords &coords, uint32_t begin, uint32_t end,
+                          Real xpos, Real ypos, Real dx, Real dy, Real radius);
+};
\ No newline at end of file
@@ -1,22 +1,17 @@
 #include "physics.hpp"
 #include "../simulation.hpp"
 #include "../entities/entity.hpp"
-#include "segment.hpp"
 #include "grid_segment_linear.hpp"
 #include "grid_segment_circular.hpp"
+#include "linear_sweep.hpp"
 #include <cmath>
 #include <limits>
-#include <sstream>
 #include <optional>
 #include <array>
 #include <tuple>
 #define M_PI 3.14159265358979323846
 
-// Static member initialization
-std::unordered_map<std::string, std::vector<std::pair<int, int>>> Physics::cellCache;
-std::unordered_map<float, float> Physics::sqrtCache;
-
-float Physics::clamp(float n, float a, float b)
+Real Physics::clamp(Real n, Real a, Real b)
 {
   return n < a ? a : (n > b ? b : n);
 }
@@ -31,137 +26,68 @@ std::pair<int, int> Physics::clampHalfCell(int xcell, int ycell)
   return {clamp(xcell, 0, 87), clamp(ycell, 0, 49)};
 }
 
-int16_t Physics::packCoord(float coord)
+int16_t Physics::packCoord(Real coord)
 {
   constexpr int16_t lim = (1 << 15) - 1;
   return static_cast<int16_t>(clamp(std::round(10 * coord), -lim, lim));
 }
 
-float Physics::getCachedSqrt(float n)
-{
-  auto it = sqrtCache.find(n);
-  if (it == sqrtCache.end())
-  {
-    it = sqrtCache.emplace(n, std::sqrt(n)).first;
-  }
-  return it->second;
-}
-
-void Physics::clearCaches()
-{
-  cellCache.clear();
-
-  // Keep frequently used sqrt values
-  sqrtCache.clear();
-  const std::array<float, 12> commonValues = {0, 1, 2, 4, 9, 16, 25, 36, 49, 64, 81, 100};
-  for (float v : commonValues)
-  {
-    sqrtCache[v] = std::sqrt(v);
-  }
-}
-
-std::vector<const Segment *> Physics::gatherSegmentsFromRegion(
-    const Simulation &sim, float x1, float y1, float x2, float y2)
-{
-  // Create cache key
-  std::stringstream key;
-  key << std::floor(x1 / 24) << "," << std::floor(y1 / 24) << ","
-      << std::floor(x2 / 24) << "," << std::floor(y2 / 24);
-
-  std::vector<std::pair<int, int>> cells;
-  auto cacheIt = cellCache.find(key.str());
-
-  if (cacheIt != cellCache.end())
-  {
-    cells = cacheIt->second;
-  }
-  else
-  {
-    auto [cx1, cy1] = clampCell(std::floor(x1 / 24), std::floor(y1 / 24));
-    auto [cx2, cy2] = clampCell(std::floor(x2 / 24), std::floor(y2 / 24));
-
-    cells.reserve((cx2 - cx1 + 1) * (cy2 - cy1 + 1));
-    for (int x = cx1; x <= cx2; ++x)
-    {
-      for (int y = cy1; y <= cy2; ++y)
-      {
-        cells.emplace_back(x, y);
-      }
-    }
-    cellCache[key.str()] = cells;
-  }
-
-  std::vector<const Segment *> segmentList;
-  for (const auto &cell : cells)
-  {
-    const auto &segments = sim.getSegmentsAt(cell);
-    for (const auto &segment : segments)
-    {
-      if (segment->isActive())
-      {
-        segmentList.push_back(segment.get());
-      }
-    }
-  }
-  return segmentList;
-}
-
 bool Physics::overlapCircleVsCircle(
-    float xpos1, float ypos1, float radius1,
-    float xpos2, float ypos2, float radius2)
+    Real xpos1, Real ypos1, Real radius1,
+    Real xpos2, Real ypos2, Real radius2)
 {
-  float dx = xpos1 - xpos2;
-  float dy = ypos1 - ypos2;
-  float distSq = dx * dx + dy * dy;
-  float radiusSum = radius1 + radius2;
+  Real dx = xpos1 - xpos2;
+  Real dy = ypos1 - ypos2;
+  Real distSq = dx * dx + dy * dy;
+  Real radiusSum = radius1 + radius2;
   return distSq < radiusSum * radiusSum;
 }
 
-float Physics::getTimeOfIntersectionCircleVsCircle(
-    float xpos, float ypos, float vx, float vy,
-    float a, float b, float radius)
+Real Physics::getTimeOfIntersectionCircleVsCircle(
+    Real xpos, Real ypos, Real vx, Real vy,
+    Real a, Real b, Real radius)
 {
-  float dx = xpos - a;
-  float dy = ypos - b;
-  float distSq = dx * dx + dy * dy;
-  float velSq = vx * vx + vy * vy;
-  float dotProd = dx * vx + dy * vy;
+  Real dx = xpos - a;
+  Real dy = ypos - b;
+  Real distSq = dx * dx + dy * dy;
+  Real velSq = vx * vx + vy * vy;
+  Real dotProd = dx * vx + dy * vy;
 
   if (distSq - radius * radius > 0)
   {
-    float radicand = dotProd * dotProd - velSq * (distSq - radius * radius);
-    if (velSq > 0.0001f && dotProd < 0 && radicand >= 0)
+    Real radicand = dotProd * dotProd - velSq * (distSq - radius * radius);
+    if (velSq > Real(0.0001) && dotProd < 0 && radicand >= 0)
     {
       return (-dotProd - std::sqrt(radicand)) / velSq;
     }
-    return 1.0f;
+    return 1.0;
   }
-  return 0.0f;
+  return 0.0;
 }
 
-float Physics::getTimeOfIntersectionCircleVsLineseg(
-    float xpos, float ypos, float dx, float dy,
-    float a1, float b1, float a2, float b2, float radius)
+Real Physics::getTimeOfIntersectionCircleVsLineseg(
+    Real xpos, Real ypos, Real dx, Real dy,
+    Real a1, Real b1, Real a2, Real b2, Real radius)
 {
-  float wx = a2 - a1;
-  float wy = b2 - b1;
-  float segLen = getCachedSqrt(wx * wx + wy * wy);
+  Real wx = a2 - a1;
+  Real wy = b2 - b1;
+  Real segLen = std::sqrt(wx * wx + wy * wy);
 
   if (segLen == 0)
-    return 1.0f;
+    return 1.0;
 
-  float nx = wx / segLen;
-  float ny = wy / segLen;
-  float normalProj = (xpos - a1) * ny - (ypos - b1) * nx;
-  float horProj = (xpos - a1) * nx + (ypos - b1) * ny;
+  Real nx = wx / segLen;
+  Real ny = wy / segLen;
+  Real normalProj = (xpos - a1) * ny - (ypos - b1) * nx;
+  Real horProj = (xpos - a1) * nx + (ypos - b1) * ny;
 
   if (std::abs(normalProj) >= radius)
   {
-    float dir = dx * ny - dy * nx;
+    Real dir = dx * ny - dy * nx;
     if (dir * normalProj < 0)
     {
-      float t = std::min((std::abs(normalProj) - radius) / std::abs(dir), 1.0f);
-      float horProj2 = horProj + t * (dx * nx + dy * ny);
+      Real t = std::min((std::abs(normalProj) - radius) / std::abs(dir), Real(1.0));
+      Real horProj2 = horProj + t * (dx * nx + dy * ny);
       if (0 <= horProj2 && horProj2 <= segLen)
       {
         return t;
@@ -170,70 +96,70 @@ float Physics::getTimeOfIntersectionCircleVsLineseg(
   }
   else if (0 <= horProj && horProj <= segLen)
   {
-    return 0.0f;
+    return 0.0;
   }
-  return 1.0f;
+  return 1.0;
 }
 
-float Physics::getTimeOfIntersectionCircleVsArc(
-    float xpos, float ypos, float vx, float vy,
-    float a, float b, float hor, float ver,
-    float radiusArc, float radiusCircle)
+Real Physics::getTimeOfIntersectionCircleVsArc(
+    Real xpos, Real ypos, Real vx, Real vy,
+    Real a, Real b, Real hor, Real ver,
+    Real radiusArc, Real radiusCircle)
 {
-  float dx = xpos - a;
-  float dy = ypos - b;
-  float distSq = dx * dx + dy * dy;
-  float velSq = vx * vx + vy * vy;
-  float dotProd = dx * vx + dy * vy;
-  float radius1 = radiusArc + radiusCircle;
-  float radius2 = radiusArc - radiusCircle;
-  float t = 1.0f;
+  Real dx = xpos - a;
+  Real dy = ypos - b;
+  Real distSq = dx * dx + dy * dy;
+  Real velSq = vx * vx + vy * vy;
+  Real dotProd = dx * vx + dy * vy;
+  Real radius1 = radiusArc + radiusCircle;
+  Real radius2 = radiusArc - radiusCircle;
+  Real t = 1.0;
 
   if (distSq > radius1 * radius1)
   {
-    float radicand = dotProd * dotProd - velSq * (distSq - radius1 * radius1);
-    if (velSq > 0.0001f && dotProd < 0 && radicand >= 0)
+    Real radicand = dotProd * dotProd - velSq * (distSq - radius1 * radius1);
+    if (velSq > Real(0.0001) && dotProd < 0 && radicand >= 0)
     {
       t = (-dotProd - std::sqrt(radicand)) / velSq;
     }
   }
   else if (distSq < radius2 * radius2)
   {
-    float radicand = dotProd * dotProd - velSq * (distSq - radius2 * radius2);
-    if (velSq > 0.0001f)
+    Real radicand = dotProd * dotProd - velSq * (distSq - radius2 * radius2);
+    if (velSq > Real(0.0001))
     {
-      t = std::min((-dotProd + std::sqrt(radicand)) / velSq, 1.0f);
+      t = std::min((-dotProd + std::sqrt(radicand)) / velSq, Real(1.0));
     }
   }
   else
   {
-    t = 0.0f;
+    t = 0.0;
   }
 
   if ((dx + t * vx) * hor > 0 && (dy + t * vy) * ver > 0)
   {
     return t;
   }
-  return 1.0f;
+  return 1.0;
 }
 
-std::pair<float, float> Physics::mapOrientationToVector(int orientation)
+std::pair<Real, Real> Physics::mapOrientationToVector(int orientation)
 {
-  static const std::array<std::pair<float, float>, 8> orientationMap = {{{1.0f, 0.0f},
-                                                                         {0.70710678118f, 0.70710678118f},
-                                                                         {0.0f, 1.0f},
-                                                                         {-0.70710678118f, 0.70710678118f},
-                                                                         {-1.0f, 0.0f},
-                                                                         {-0.70710678118f, -0.70710678118f},
-                                                                         {0.0f, -1.0f},
-                                                                         {0.70710678118f, -0.70710678118f}}};
+  static const std::array<std::pair<Real, Real>, 8> orientationMap = {{{Real(1.0), Real(0.0)},
+                                                                       {Real(0.70710678118), Real(0.70710678118)},
+                                                                         {Real(0.0), Real(1.0)},
+                                                                         {Real(-0.70710678118), Real(0.70710678118)},
+                                                                         {Real(-1.0), Real(0.0)},
+                                                                         {Real(-0.70710678118), Real(-0.70710678118)},
+                                                                         {Real(0.0), Real(-1.0)},
+                                                                         {Real(0.70710678118), Real(-0.70710678118)}}};
 
   return orientationMap[orientation % 8];
 }
 
-int Physics::mapVectorToOrientation(float xdir, float ydir)
+int Physics::mapVectorToOrientation(Real xdir, Real ydir)
 {
-  float angle = std::atan2(ydir, xdir);
+  Real angle = std::atan2(ydir, xdir);
   if (angle < 0)
   {
     angle += 2 * M_PI;
@@ -241,13 +167,13 @@ int Physics::mapVectorToOrientation(float xdir, float ydir)
   return static_cast<int>(std::round(8 * angle / (2 * M_PI))) % 8;
 }
 
-std::optional<float> Physics::getRaycastDistance(
-    const Simulation &sim, float xpos, float ypos, float dx, float dy)
+std::optional<Real> Physics::getRaycastDistance(
+    const Simulation &sim, Real xpos, Real ypos, Real dx, Real dy)
 {
   int xcell = std::floor(xpos / 24);
   int ycell = std::floor(ypos / 24);
 
-  float tmaxX, tmaxY, deltaX, deltaY;
+  Real tmaxX, tmaxY, deltaX, deltaY;
   int stepX, stepY;
 
   if (dx > 0)
@@ -266,7 +192,7 @@ std::optional<float> Physics::getRaycastDistance(
   {
     stepX = 0;
     deltaX = 0;
-    tmaxX = std::numeric_limits<float>::max();
+    tmaxX = std::numeric_limits<Real>::max();
   }
 
   if (dy > 0)
@@ -285,10 +211,10 @@ std::optional<float> Physics::getRaycastDistance(
   {
     stepY = 0;
     deltaY = 0;
-    tmaxY = std::numeric_limits<float>::max();
+    tmaxY = std::numeric_limits<Real>::max();
   }
 
-  float dist = 0;
+  Real dist = 0;
   while (dist < 1)
   {
     if (tmaxX < tmaxY)
@@ -308,7 +234,12 @@ std::optional<float> Physics::getRaycastDistance(
       tmaxY += deltaY;
     }
 
-    float cellDist = intersectRayVsCellContents(sim, xcell, ycell, xpos, ypos, dx, dy);
+    // Empty cells can't stop the ray. Inactive door segments still do, so the
+    // occupancy only changes when the map is loaded.
+    if (!sim.hasSegmentsAt(clampCell(xcell, ycell)))
+      continue;
+
+    Real cellDist = intersectRayVsCellContents(sim, xcell, ycell, xpos, ypos, dx, dy);
     if (cellDist < 1)
     {
       return cellDist;
@@ -319,12 +250,12 @@ std::optional<float> Physics::getRaycastDistance(
 }
 
 bool Physics::raycastVsPlayer(
-    const Simulation &sim, float xstart, float ystart,
-    float ninjaXpos, float ninjaYpos, float ninjaRadius)
+    const Simulation &sim, Real xstart, Real ystart,
+    Real ninjaXpos, Real ninjaYpos, Real ninjaRadius)
 {
-  float dx = ninjaXpos - xstart;
-  float dy = ninjaYpos - ystart;
-  float dist = getCachedSqrt(dx * dx + dy * dy);
+  Real dx = ninjaXpos - xstart;
+  Real dy = ninjaYpos - ystart;
+  Real dist = std::sqrt(dx * dx + dy * dy);
 
   if (ninjaRadius <= dist && dist > 0)
   {
@@ -336,217 +267,273 @@ bool Physics::raycastVsPlayer(
   return false;
 }
 
+bool Physics::isRaycastVsPlayerStatic(const Simulation &sim, Real xstart, Real ystart)
+{
+  // The unit length rays of raycastVsPlayer stop after their first pixel, so
+  // only segments of the cells within a pixel of the origin can be reported.
+  // Cells are tested for segments of any state, as inactive doors still stop
+  // rays, with some slack for the rounding of the walk.
+  int minX = std::max(static_cast<int>(std::floor((xstart - 2) / 24)), 0);
+  int maxX = std::min(static_cast<int>(std::floor((xstart + 2) / 24)), 43);
+  int minY = std::max(static_cast<int>(std::floor((ystart - 2) / 24)), 0);
+  int maxY = std::min(static_cast<int>(std::floor((ystart + 2) / 24)), 24);
+  for (int x = minX; x <= maxX; ++x)
+  {
+    for (int y = minY; y <= maxY; ++y)
+    {
+      if (sim.hasSegmentsAt({x, y}))
+        return false;
+    }
+  }
+  return true;
+}
+
 bool Physics::overlapCircleVsSegment(
-    float xpos, float ypos, float radius,
-    float px1, float py1, float px2, float py2)
+    Real xpos, Real ypos, Real radius,
+    Real px1, Real py1, Real px2, Real py2)
 {
-  float wx = px2 - px1;
-  float wy = py2 - py1;
-  float segLen = getCachedSqrt(wx * wx + wy * wy);
+  Real wx = px2 - px1;
+  Real wy = py2 - py1;
+  Real segLen = std::sqrt(wx * wx + wy * wy);
 
   if (segLen == 0)
     return false;
 
-  float nx = wx / segLen;
-  float ny = wy / segLen;
-  float normalProj = (xpos - px1) * ny - (ypos - py1) * nx;
-  float horProj = (xpos - px1) * nx + (ypos - py1) * ny;
+  Real nx = wx / segLen;
+  Real ny = wy / segLen;
+  Real normalProj = (xpos - px1) * ny - (ypos - py1) * nx;
+  Real horProj = (xpos - px1) * nx + (ypos - py1) * ny;
 
   return std::abs(normalProj) < radius && 0 <= horProj && horProj <= segLen;
 }
 
-std::optional<std::tuple<std::pair<float, float>, std::pair<float, float>>>
-Physics::penetrationSquareVsPoint(float sXpos, float sYpos, float pXpos, float pYpos, float semiSide)
+std::optional<std::tuple<std::pair<Real, Real>, std::pair<Real, Real>>>
+Physics::penetrationSquareVsPoint(Real sXpos, Real sYpos, Real pXpos, Real pYpos, Real semiSide)
 {
-  float dx = pXpos - sXpos;
-  float dy = pYpos - sYpos;
-  float penx = semiSide - std::abs(dx);
-  float peny = semiSide - std::abs(dy);
+  Real dx = pXpos - sXpos;
+  Real dy = pYpos - sYpos;
+  Real penx = semiSide - std::abs(dx);
+  Real peny = semiSide - std::abs(dy);
 
   if (penx > 0 && peny > 0)
   {
     if (peny <= penx)
     {
-      std::pair<float, float> depenNormal{0.0f, dy < 0 ? -1.0f : 1.0f};
-      std::pair<float, float> depenValues{peny, penx};
+      std::pair<Real, Real> depenNormal{Real(0.0), dy < 0 ? Real(-1.0) : Real(1.0)};
+      std::pair<Real, Real> depenValues{peny, penx};
       return std::make_tuple(depenNormal, depenValues);
     }
     else
     {
-      std::pair<float, float> depenNormal{dx < 0 ? -1.0f : 1.0f, 0.0f};
-      std::pair<float, float> depenValues{penx, peny};
+      std::pair<Real, Real> depenNormal{dx < 0 ? Real(-1.0) : Real(1.0), Real(0.0)};
+      std::pair<Real, Real> depenValues{penx, peny};
       return std::make_tuple(depenNormal, depenValues);
     }
   }
   return std::nullopt;
 }
 
-std::vector<Entity *> Physics::gatherEntitiesFromNeighbourhood(
-    const Simulation &sim, float xpos, float ypos)
+void Physics::gatherEntitiesFromNeighbourhood(
+    const Simulation &sim, Real xpos, Real ypos, std::vector<Entity *> &entityList)
 {
   auto [cx, cy] = clampCell(std::floor(xpos / 24), std::floor(ypos / 24));
+  int minX = std::max(cx - 1, 0);
+  int maxX = std::min(cx + 1, 43);
+  int minY = std::max(cy - 1, 0);
+  int maxY = std::min(cy + 1, 24);
 
-  std::stringstream key;
-  key << cx << "," << cy;
-
-  std::vector<std::pair<int, int>> cells;
-  auto cacheIt = cellCache.find(key.str());
-
-  if (cacheIt != cellCache.end())
-  {
-    cells = cacheIt->second;
-  }
-  else
+  entityList.clear();
+  for (int x = minX; x <= maxX; ++x)
   {
-    int minX = std::max(cx - 1, 0);
-    int maxX = std::min(cx + 1, 43);
-    int minY = std::max(cy - 1, 0);
-    int maxY = std::min(cy + 1, 24);
-
-    cells.reserve((maxX - minX + 1) * (maxY - minY + 1));
-    for (int x = minX; x <= maxX; ++x)
+    for (int y = minY; y <= maxY; ++y)
     {
-      for (int y = minY; y <= maxY; ++y)
+      for (const auto &entity : sim.getEntitiesAt({x, y}))
       {
-        cells.emplace_back(x, y);
+        if (entity->isActive())
+        {
+          entityList.push_back(entity);
+        }
       }
     }
-    cellCache[key.str()] = cells;
   }
+}
 
-  std::vector<Entity *> entityList;
-
-  for (const auto &cell : cells)
+namespace
+{
+  // Whether the cell of a position inside the map or any cell next to it holds door
+  // segments, active or not. These are all the cells a query reaching less than a
+  // cell away from the position can visit.
+  bool hasDoorSegmentsAround(const Simulation &sim, Real xpos, Real ypos)
   {
-    const auto &entities = sim.getEntitiesAt(cell);
-    for (const auto &entity : entities)
-    {
-      if (entity->isActive())
-      {
-        entityList.push_back(entity.get());
-      }
-    }
+    auto cell = Physics::clampCell(static_cast<int>(xpos / 24), static_cast<int>(ypos / 24));
+    return sim.getDoorSegments().hasLinearsAround(cell);
   }
-
-  return entityList;
 }
 
-float Physics::sweepCircleVsTiles(
-    const Simulation &sim, float xposOld, float yposOld,
-    float dx, float dy, float radius)
+Real Physics::sweepCircleVsTiles(
+    const Simulation &sim, Real xposOld, Real yposOld,
+    Real dx, Real dy, Real radius)
 {
-  float xposNew = xposOld + dx;
-  float yposNew = yposOld + dy;
-  float width = radius + 1;
-  float x1 = std::min(xposOld, xposNew) - width;
-  float y1 = std::min(yposOld, yposNew) - width;
-  float x2 = std::max(xposOld, xposNew) + width;
-  float y2 = std::max(yposOld, yposNew) + width;
-
-  auto segments = gatherSegmentsFromRegion(sim, x1, y1, x2, y2);
-  float shortestTime = 1.0f;
-
-  for (const auto &segment : segments)
-  {
-    float time = segment->intersectWithRay(xposOld, yposOld, dx, dy, radius);
+  // Nothing within reach of the whole move, so every segment would give 1.
+  // A positive clearance also means the position is inside the map.
+  Real reach = radius + std::sqrt(dx * dx + dy * dy);
+  if (sim.getCompiledMap()->getClearance().getClearance(xposOld, yposOld) > reach &&
+      !hasDoorSegmentsAround(sim, xposOld, yposOld))
+  {
+    return 1.0;
+  }
+
+  Real xposNew = xposOld + dx;
+  Real yposNew = yposOld + dy;
+  Real width = radius + 1;
+  Real x1 = std::min(xposOld, xposNew) - width;
+  Real y1 = std::min(yposOld, yposNew) - width;
+  Real x2 = std::max(xposOld, xposNew) + width;
+  Real y2 = std::max(yposOld, yposNew) + width;
+
+  auto [cx1, cy1] = clampCell(std::floor(x1 / 24), std::floor(y1 / 24));
+  auto [cx2, cy2] = clampCell(std::floor(x2 / 24), std::floor(y2 / 24));
+
+  // Tile linears make up most of the candidates. The cells of one row are
+  // adjacent in the store, so each row is a single run for the vectorized kernel.
+  const SegmentStore &tileSegments = sim.getCompiledMap()->getSegments();
+  Real shortestTime = 1.0;
+  for (int y = cy1; y <= cy2; ++y)
+  {
+    Real time = LinearSweep::sweep(tileSegments.getLinearCoords(),
+                                   tileSegments.linearBegin({cx1, y}), tileSegments.linearEnd({cx2, y}),
+                                    xposOld, yposOld, dx, dy, radius);
     shortestTime = std::min(time, shortestTime);
   }
 
+  // Door segments and tile arcs are few and stay on the scalar path
+  auto visitScalar = [&](const auto &segment)
+  {
+    if (segment.isActive())
+    {
+      Real time = segment.intersectWithRay(xposOld, yposOld, dx, dy, radius);
+      shortestTime = std::min(time, shortestTime);
+    }
+  };
+  const TileDictionary &tiles = sim.getTileDic();
+  for (int x = cx1; x <= cx2; ++x)
+  {
+    for (int y = cy1; y <= cy2; ++y)
+    {
+      sim.getDoorSegments().forEachLinearInCell({x, y}, visitScalar);
+      TileSegments::forEachCircularInCell(tiles[{x, y}], {x, y}, visitScalar);
+    }
+  }
+
   return shortestTime;
 }
 
-std::optional<std::tuple<bool, std::pair<float, float>>>
-Physics::getSingleClosestPoint(const Simulation &sim, float xpos, float ypos, float radius)
+namespace
 {
-  auto segments = gatherSegmentsFromRegion(sim, xpos - radius, ypos - radius, xpos + radius, ypos + radius);
-  float shortestDistance = std::numeric_limits<float>::infinity();
-  bool result = false;
-  std::pair<float, float> closestPoint;
+  // Closest point among the segments visited by forEachSegment, preferring
+  // front faces. Ties keep the first segment visited.
+  template <typename ForEachSegment>
+  std::optional<std::tuple<bool, std::pair<Real, Real>>>
+  closestPointAmong(ForEachSegment &&forEachSegment, Real xpos, Real ypos)
+  {
+    Real shortestDistance = std::numeric_limits<Real>::infinity();
+    bool result = false;
+    std::pair<Real, Real> closestPoint;
+
+    forEachSegment([&](const auto &segment)
+                   {
+      if (!segment.isActive())
+        return;
+
+      auto [isBackFacing, a, b] = segment.getClosestPoint(xpos, ypos);
+      Real distanceSq = (xpos - a) * (xpos - a) + (ypos - b) * (ypos - b);
+
+      // This is to prioritize correct side collisions when multiple close segments
+      if (!isBackFacing)
+      {
+        distanceSq -= 0.1;
+      }
 
-  for (const auto &segment : segments)
-  {
-    auto [isBackFacing, a, b] = segment->getClosestPoint(xpos, ypos);
-    float distanceSq = (xpos - a) * (xpos - a) + (ypos - b) * (ypos - b);
+      if (distanceSq < shortestDistance)
+      {
+        shortestDistance = distanceSq;
+        closestPoint = {a, b};
+        result = isBackFacing;
+      } });
 
-    // This is to prioritize correct side collisions when multiple close segments
-    if (!isBackFacing)
+    if (shortestDistance == std::numeric_limits<Real>::infinity())
     {
-      distanceSq -= 0.1f;
+      return std::nullopt;
     }
 
-    if (distanceSq < shortestDistance)
-    {
-      shortestDistance = distanceSq;
-      closestPoint = {a, b};
-      result = isBackFacing;
-    }
+    return std::make_tuple(result, closestPoint);
   }
+}
 
-  if (shortestDistance == std::numeric_limits<float>::infinity())
-  {
-    return std::nullopt;
-  }
+std::optional<std::tuple<bool, std::pair<Real, Real>>>
+Physics::getSingleClosestPoint(const Simulation &sim, Real xpos, Real ypos, Real radius)
+{
+  return closestPointAmong([&](auto &&visitor)
+                           { forEachSegmentInRegion(sim, xpos - radius, ypos - radius, xpos + radius, ypos + radius, visitor); },
+                           xpos, ypos);
+}
 
-  return std::make_tuple(result, closestPoint);
+std::optional<std::tuple<bool, std::pair<Real, Real>>>
+Physics::getSingleClosestPoint(const SegmentCache &cache, const SegmentCache::CellBox &cells, Real xpos, Real ypos)
+{
+  return closestPointAmong([&](auto &&visitor)
+                           { cache.forEachInBox(cells, visitor); },
+                           xpos, ypos);
+}
+
+bool Physics::isClearOfTiles(const Simulation &sim, Real xpos, Real ypos, Real radius)
+{
+  return sim.getCompiledMap()->getClearance().getClearance(xpos, ypos) > radius &&
+         !hasDoorSegmentsAround(sim, xpos, ypos);
 }
 
 bool Physics::isEmptyRow(
     const Simulation &sim, int xcoord1, int xcoord2, int ycoord, int dir)
 {
-  for (int xcoord = xcoord1; xcoord <= xcoord2; ++xcoord)
+  if (xcoord1 > xcoord2 || (dir != 1 && dir != -1))
   {
-    if (dir == 1)
-    {
-      auto [x, y] = clampHalfCell(xcoord, ycoord + 1);
-      if (sim.hasHorizontalEdge({x, y}))
-        return false;
-    }
-    else if (dir == -1)
-    {
-      auto [x, y] = clampHalfCell(xcoord, ycoord);
-      if (sim.hasHorizontalEdge({x, y}))
-        return false;
-    }
+    return true;
   }
-  return true;
+
+  // Clamping keeps the span contiguous, so the whole row segment is one mask test
+  auto [x1, y] = clampHalfCell(xcoord1, dir == 1 ? ycoord + 1 : ycoord);
+  int x2 = clampHalfCell(xcoord2, y).first;
+  return !sim.getHorEdgeBits().anyInSpan(y, x1, x2);
 }
 
 bool Physics::isEmptyColumn(
     const Simulation &sim, int xcoord, int ycoord1, int ycoord2, int dir)
 {
-  for (int ycoord = ycoord1; ycoord <= ycoord2; ++ycoord)
+  if (ycoord1 > ycoord2 || (dir != 1 && dir != -1))
   {
-    if (dir == 1)
-    {
-      auto [x, y] = clampHalfCell(xcoord + 1, ycoord);
-      if (sim.hasVerticalEdge({x, y}))
-        return false;
-    }
-    else if (dir == -1)
-    {
-      auto [x, y] = clampHalfCell(xcoord, ycoord);
-      if (sim.hasVerticalEdge({x, y}))
-        return false;
-    }
+    return true;
   }
-  return true;
+
+  auto [x, y1] = clampHalfCell(dir == 1 ? xcoord + 1 : xcoord, ycoord1);
+  int y2 = clampHalfCell(x, ycoord2).second;
+  return !sim.getVerEdgeBits().anyInSpan(x, y1, y2);
 }
 
 bool Physics::checkLinesegVsNinja(
-    float x1, float y1, float x2, float y2, const Ninja &ninja)
+    Real x1, Real y1, Real x2, Real y2, const Ninja &ninja)
 {
-  float dx = x2 - x1;
-  float dy = y2 - y1;
-  float len = getCachedSqrt(dx * dx + dy * dy);
+  Real dx = x2 - x1;
+  Real dy = y2 - y1;
+  Real len = std::sqrt(dx * dx + dy * dy);
   if (len == 0)
     return false;
 
   // This part returns false if the segment does not intersect the ninja's circular hitbox
   dx /= len;
   dy /= len;
-  float proj = (ninja.xpos - x1) * dx + (ninja.ypos - y1) * dy;
-  float x = x1;
-  float y = y1;
+  Real proj = (ninja.xpos - x1) * dx + (ninja.ypos - y1) * dy;
+  Real x = x1;
+  Real y = y1;
   if (proj > 0)
   {
     x += dx * proj;
@@ -573,15 +560,15 @@ bool Physics::checkLinesegVsNinja(
   {
     const auto &bone1 = ninja.bones[seg.first];
     const auto &bone2 = ninja.bones[seg.second];
-    float x3 = ninja.xpos + 24 * bone1.first;
-    float y3 = ninja.ypos + 24 * bone1.second;
-    float x4 = ninja.xpos + 24 * bone2.first;
-    float y4 = ninja.ypos + 24 * bone2.second;
+    Real x3 = ninja.xpos + 24 * bone1.first;
+    Real y3 = ninja.ypos + 24 * bone1.second;
+    Real x4 = ninja.xpos + 24 * bone2.first;
+    Real y4 = ninja.ypos + 24 * bone2.second;
 
-    float det1 = (x1 - x3) * (y2 - y3) - (y1 - y3) * (x2 - x3);
-    float det2 = (x1 - x4) * (y2 - y4) - (y1 - y4) * (x2 - x4);
-    float det3 = (x3 - x1) * (y4 - y1) - (y3 - y1) * (x4 - x1);
-    float det4 = (x3 - x2) * (y4 - y2) - (y3 - y2) * (x4 - x2);
+    Real det1 = (x1 - x3) * (y2 - y3) - (y1 - y3) * (x2 - x3);
+    Real det2 = (x1 - x4) * (y2 - y4) - (y1 - y4) * (x2 - x4);
+    Real det3 = (x3 - x1) * (y4 - y1) - (y3 - y1) * (x4 - x1);
+    Real det4 = (x3 - x2) * (y4 - y2) - (y3 - y2) * (x4 - x2);
 
     if (det1 * det2 < 0 && det3 * det4 < 0)
       return true;
@@ -593,16 +580,14 @@ bool Physics::checkLinesegVsNinja(
  * Given a cell and a ray, return the shortest time of intersection between the ray and one of
  * the cell's tile segments. Return 1 if the ray hits nothing.
  */
-float Physics::intersectRayVsCellContents(
+Real Physics::intersectRayVsCellContents(
     const Simulation &sim, int xcell, int ycell,
-    float xpos, float ypos, float dx, float dy)
+    Real xpos, Real ypos, Real dx, Real dy)
 {
-  auto segments = sim.getSegmentsAt(clampCell(xcell, ycell));
-  float shortestTime = 1.0f;
-  for (const auto &segment : segments)
-  {
-    float time = segment->intersectWithRay(xpos, ypos, dx, dy, 0);
-    shortestTime = std::min(time, shortestTime);
-  }
+  Real shortestTime = 1.0;
+  sim.forEachSegmentInCell(clampCell(xcell, ycell), [&](const auto &segment)
+                           {
+    Real time = segment.intersectWithRay(xpos, ypos, dx, dy, 0);
+    shortestTime = std::min(time, shortestTime); });
   return shortestTime;
 }
@@ -2,14 +2,13 @@
 
 #include "../simulation.hpp"
 #include "../ninja.hpp"
+#include "segment_cache.hpp"
 #include <vector>
-#include <unordered_map>
 #include <cmath>
 #include <array>
 #include <tuple>
 #include <optional>
 #include <algorithm>
-#include <string>
 
 class Entity;
 
@@ -17,31 +16,36 @@ class Physics
 {
 public:
     // Utility functions
-    static float clamp(float n, float a, float b);
+    static Real clamp(Real n, Real a, Real b);
     static std::pair<int, int> clampCell(int xcell, int ycell);
     static std::pair<int, int> clampHalfCell(int xcell, int ycell);
-    static int16_t packCoord(float coord);
+    static int16_t packCoord(Real coord);
 
-    // Cache management
-    static void clearCaches();
+    // Spatial queries. These never allocate: segments are visited in place and
+    // entities are written to a caller-owned buffer that keeps its capacity.
+    template <typename Visitor>
+    static void forEachSegmentInRegion(
+        const Simulation &sim, Real x1, Real y1, Real x2, Real y2, Visitor &&visitor);
 
-    // Geometry calculations
-    static std::vector<const Segment *> gatherSegmentsFromRegion(
-        const Simulation &sim, float x1, float y1, float x2, float y2);
+    static void gatherEntitiesFromNeighbourhood(
+        const Simulation &sim, Real xpos, Real ypos, std::vector<Entity *> &entityList);
 
-    static std::vector<Entity *> gatherEntitiesFromNeighbourhood(
-        const Simulation &sim, float xpos, float ypos);
+    static Real sweepCircleVsTiles(
+        const Simulation &sim, Real xposOld, Real yposOld,
+        Real dx, Real dy, Real radius);
 
-    static float sweepCircleVsTiles(
-        const Simulation &sim, float xposOld, float yposOld,
-        float dx, float dy, float radius);
+    // True when a closest point query of this radius (below ClearanceField::MAX_RADIUS)
+    // is known to find only front facing segments farther than the radius, so a
+    // depenetration pass would leave the circle untouched. Positions next to a
+    // cell holding door segments, active or not, are never assumed clear.
+    static bool isClearOfTiles(const Simulation &sim, Real xpos, Real ypos, Real radius);
 
-    static std::optional<std::tuple<std::pair<float, float>, std::pair<float, float>>>
-    penetrationSquareVsPoint(float sXpos, float sYpos, float pXpos, float pYpos, float semiSide);
+    static std::optional<std::tuple<std::pair<Real, Real>, std::pair<Real, Real>>>
+    penetrationSquareVsPoint(Real sXpos, Real sYpos, Real pXpos, Real pYpos, Real semiSide);
 
     static bool overlapCircleVsCircle(
-        float xpos1, float ypos1, float radius1,
-        float xpos2, float ypos2, float radius2);
+        Real xpos1, Real ypos1, Real radius1,
+        Real xpos2, Real ypos2, Real radius2);
 
     static bool isEmptyRow(
         const Simulation &sim, int xcoord1, int xcoord2, int ycoord, int dir);
@@ -49,48 +53,65 @@ public:
     static bool isEmptyColumn(
         const Simulation &sim, int xcoord, int ycoord1, int ycoord2, int dir);
 
-    static int mapVectorToOrientation(float xdir, float ydir);
+    static int mapVectorToOrientation(Real xdir, Real ydir);
 
-    static float getTimeOfIntersectionCircleVsCircle(
-        float xpos, float ypos, float vx, float vy,
-        float a, float b, float radius);
+    static Real getTimeOfIntersectionCircleVsCircle(
+        Real xpos, Real ypos, Real vx, Real vy,
+        Real a, Real b, Real radius);
 
-    static float getTimeOfIntersectionCircleVsLineseg(
-        float xpos, float ypos, float dx, float dy,
-        float a1, float b1, float a2, float b2, float radius);
+    static Real getTimeOfIntersectionCircleVsLineseg(
+        Real xpos, Real ypos, Real dx, Real dy,
+        Real a1, Real b1, Real a2, Real b2, Real radius);
 
-    static float getTimeOfIntersectionCircleVsArc(
-        float xpos, float ypos, float vx, float vy,
-        float a, float b, float hor, float ver,
-        float radiusArc, float radiusCircle);
+    static Real getTimeOfIntersectionCircleVsArc(
+        Real xpos, Real ypos, Real vx, Real vy,
+        Real a, Real b, Real hor, Real ver,
+        Real radiusArc, Real radiusCircle);
 
-    static std::pair<float, float> mapOrientationToVector(int orientation);
+    static std::pair<Real, Real> mapOrientationToVector(int orientation);
 
-    static std::optional<float> getRaycastDistance(
-        const Simulation &sim, float xpos, float ypos, float dx, float dy);
+    static std::optional<Real> getRaycastDistance(
+        const Simulation &sim, Real xpos, Real ypos, Real dx, Real dy);
 
-    static float intersectRayVsCellContents(
+    static Real intersectRayVsCellContents(
         const Simulation &sim, int xcell, int ycell,
-        float xpos, float ypos, float dx, float dy);
+        Real xpos, Real ypos, Real dx, Real dy);
 
     static bool raycastVsPlayer(
-        const Simulation &sim, float xstart, float ystart,
-        float ninjaXpos, float ninjaYpos, float ninjaRadius);
+        const Simulation &sim, Real xstart, Real ystart,
+        Real ninjaXpos, Real ninjaYpos, Real ninjaRadius);
+
+    // Whether raycastVsPlayer from this origin returns false whatever the target.
+    // The result only changes when the map is loaded.
+    static bool isRaycastVsPlayerStatic(const Simulation &sim, Real xstart, Real ystart);
 
     static bool checkLinesegVsNinja(
-        float x1, float y1, float x2, float y2, const Ninja &ninja);
+        Real x1, Real y1, Real x2, Real y2, const Ninja &ninja);
 
     static bool overlapCircleVsSegment(
-        float xpos, float ypos, float radius,
-        float px1, float py1, float px2, float py2);
+        Real xpos, Real ypos, Real radius,
+        Real px1, Real py1, Real px2, Real py2);
 
-    static std::optional<std::tuple<bool, std::pair<float, float>>>
-    getSingleClosestPoint(const Simulation &sim, float xpos, float ypos, float radius);
+    static std::optional<std::tuple<bool, std::pair<Real, Real>>>
+    getSingleClosestPoint(const Simulation &sim, Real xpos, Real ypos, Real radius);
 
-private:
-    // Cache for frequently used calculations
-    static std::unordered_map<std::string, std::vector<std::pair<int, int>>> cellCache;
-    static std::unordered_map<float, float> sqrtCache;
+    // Same query over segments gathered in advance; cells must lie within the cache
+    static std::optional<std::tuple<bool, std::pair<Real, Real>>>
+    getSingleClosestPoint(const SegmentCache &cache, const SegmentCache::CellBox &cells, Real xpos, Real ypos);
+};
 
-    static float getCachedSqrt(float n);
-};
\ No newline at end of file
+template <typename Visitor>
+void Physics::forEachSegmentInRegion(
+    const Simulation &sim, Real x1, Real y1, Real x2, Real y2, Visitor &&visitor)
+{
+    auto [cx1, cy1] = clampCell(std::floor(x1 / 24), std::floor(y1 / 24));
+    auto [cx2, cy2] = clampCell(std::floor(x2 / 24), std::floor(y2 / 24));
+
+    for (int x = cx1; x <= cx2; ++x)
+    {
+        for (int y = cy1; y <= cy2; ++y)
+        {
+            sim.forEachSegmentInCell({x, y}, visitor);
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,56 @@
+#include "segment_cache.hpp"
+#include "physics.hpp"
+#include "../simulation.hpp"
+#include <cmath>
+#include <stdexcept>
+
+SegmentCache::CellBox SegmentCache::regionCells(Real x1, Real y1, Real x2, Real y2)
+{
+  auto [cx1, cy1] = Physics::clampCell(std::floor(x1 / 24), std::floor(y1 / 24));
+  auto [cx2, cy2] = Physics::clampCell(std::floor(x2 / 24), std::floor(y2 / 24));
+  return {cx1, cy1, cx2, cy2};
+}
+
+void SegmentCache::gather(const Simulation &sim, const CellBox &box)
+{
+  if (box.x2 - box.x1 >= MAX_SPAN || box.y2 - box.y1 >= MAX_SPAN)
+  {
+    throw std::out_of_range("Segment cache box is too large");
+  }
+
+  cached = box;
+  linears.clear();
+
+  const SegmentStore &tileSegments = sim.getCompiledMap()->getSegments();
+  const SegmentStore &doorSegments = sim.getDoorSegments();
+  auto addLinear = [&](const GridSegmentLinear &segment)
+  {
+    if (segment.isActive())
+    {
+      linears.push_back(segment);
+    }
+  };
+
+  for (int x = box.x1; x <= box.x2; ++x)
+  {
+    for (int y = box.y1; y <= box.y2; ++y)
+    {
+      CellRange &range = ranges[index(x, y)];
+      range.tileId = sim.getTileDic()[{x, y}];
+      range.linearBegin = linears.size();
+
+      // A slope is the first linear of its cell and is visited from the tile id instead
+      bool skipSlope = TileSegments::hasLinear(range.tileId);
+      tileSegments.forEachLinearInCell({x, y}, [&](const GridSegmentLinear &segment)
+                                       {
+        if (skipSlope)
+        {
+          skipSlope = false;
+          return;
+        }
+        addLinear(segment); });
+      doorSegments.forEachLinearInCell({x, y}, addLinear);
+      range.linearEnd = linears.size();
+    }
+  }
+}
\ No newline at end of file
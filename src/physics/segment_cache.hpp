@@ -0,0 +1,71 @@
+#pragma once
+
+#include "grid_segment_linear.hpp"
+#include "tile_segments.hpp"
+
+#include <array>
+#include <vector>
+#include <cstdint>
+
+class Simulation;
+
+// Active segments of a small block of cells, copied out of the tile and door
+// stores once so that repeated queries around a moving circle (the ninja's
+// depenetration loop) do not look them up again. Queries visit the segments
+// of a cell range in the same order as Physics::forEachSegmentInRegion.
+//
+// Only orthogonal tile segments and door segments are copied. Slopes and arcs
+// are visited through the TileSegment specialization of each cell's tile.
+class SegmentCache
+{
+public:
+  // Inclusive cell range
+  struct CellBox
+  {
+    int x1, y1, x2, y2;
+  };
+
+  static constexpr int MAX_SPAN = 5;
+
+  // Cells overlapped by a region, clamped the same way as Physics::forEachSegmentInRegion
+  static CellBox regionCells(Real x1, Real y1, Real x2, Real y2);
+
+  // Throws std::out_of_range if the box spans more than MAX_SPAN cells on a side
+  void gather(const Simulation &sim, const CellBox &box);
+  bool covers(const CellBox &box) const
+  {
+    return box.x1 >= cached.x1 && box.x2 <= cached.x2 && box.y1 >= cached.y1 && box.y2 <= cached.y2;
+  }
+
+  template <typename Visitor>
+  void forEachInBox(const CellBox &box, Visitor &&visitor) const
+  {
+    for (int x = box.x1; x <= box.x2; ++x)
+    {
+      for (int y = box.y1; y <= box.y2; ++y)
+      {
+        const CellRange &range = ranges[index(x, y)];
+        TileSegments::forEachLinearInCell(range.tileId, {x, y}, visitor);
+        for (uint32_t i = range.linearBegin; i < range.linearEnd; ++i)
+        {
+          visitor(linears[i]);
+        }
+        TileSegments::forEachCircularInCell(range.tileId, {x, y}, visitor);
+      }
+    }
+  }
+
+private:
+  struct CellRange
+  {
+    uint32_t linearBegin = 0;
+    uint32_t linearEnd = 0;
+    int tileId = 0;
+  };
+
+  int index(int x, int y) const { return (x - cached.x1) * MAX_SPAN + (y - cached.y1); }
+
+  CellBox cached{0, 0, -1, -1};
+  std::array<CellRange, MAX_SPAN * MAX_SPAN> ranges;
+  std::vector<GridSegmentLinear> linears;
+};
\ No newline at end of file
@@ -0,0 +1,144 @@
+#include "segment_store.hpp"
+#include <algorithm>
+#include <numeric>
+
+void SegmentStore::clear()
+{
+  stagedLinears.clear();
+  stagedCirculars.clear();
+  tileLinearCount = 0;
+  linears.clear();
+  circulars.clear();
+  doorSlots.clear();
+  linearCoords = LinearCoords();
+  ranges.fill(CellRange());
+  occupiedRows.fill(0);
+  linearsAround.fill(false);
+}
+
+void SegmentStore::clearDoors()
+{
+  stagedLinears.erase(stagedLinears.begin() + tileLinearCount, stagedLinears.end());
+  doorSlots.clear();
+}
+
+void SegmentStore::addLinear(const CellCoord &cell, const GridSegmentLinear &segment)
+{
+  stagedLinears.push_back({cellIndex(cell), segment});
+  tileLinearCount = stagedLinears.size();
+}
+
+void SegmentStore::addCircular(const CellCoord &cell, const GridSegmentCircular &segment)
+{
+  stagedCirculars.push_back({cellIndex(cell), segment});
+}
+
+std::size_t SegmentStore::addDoor(const CellCoord &cell, const GridSegmentLinear &segment)
+{
+  stagedLinears.push_back({cellIndex(cell), segment});
+  return stagedLinears.size() - tileLinearCount - 1;
+}
+
+void SegmentStore::setDoorActive(std::size_t doorId, bool active)
+{
+  stagedLinears[tileLinearCount + doorId].segment.setActive(active);
+  if (doorId < doorSlots.size())
+  {
+    linears[doorSlots[doorId]].setActive(active);
+  }
+}
+
+void SegmentStore::build()
+{
+  constexpr int cellCount = WIDTH * HEIGHT;
+
+  // Stable sort by cell keeps the insertion order within each cell
+  std::vector<uint32_t> linearOrder(stagedLinears.size());
+  std::vector<uint32_t> circularOrder(stagedCirculars.size());
+  std::iota(linearOrder.begin(), linearOrder.end(), 0);
+  std::iota(circularOrder.begin(), circularOrder.end(), 0);
+  std::stable_sort(linearOrder.begin(), linearOrder.end(), [this](uint32_t a, uint32_t b)
+                   { return stagedLinears[a].cellIndex < stagedLinears[b].cellIndex; });
+  std::stable_sort(circularOrder.begin(), circularOrder.end(), [this](uint32_t a, uint32_t b)
+                   { return stagedCirculars[a].cellIndex < stagedCirculars[b].cellIndex; });
+
+  linears.clear();
+  linears.reserve(stagedLinears.size());
+  doorSlots.assign(stagedLinears.size() - tileLinearCount, 0);
+  for (uint32_t i : linearOrder)
+  {
+    if (i >= tileLinearCount)
+    {
+      doorSlots[i - tileLinearCount] = linears.size();
+    }
+    linears.push_back(stagedLinears[i].segment);
+  }
+
+  linearCoords.x1.assign(linears.size() + COORD_PADDING, Real(0.0));
+  linearCoords.y1.assign(linears.size() + COORD_PADDING, Real(0.0));
+  linearCoords.x2.assign(linears.size() + COORD_PADDING, Real(0.0));
+  linearCoords.y2.assign(linears.size() + COORD_PADDING, Real(0.0));
+  for (size_t i = 0; i < linears.size(); ++i)
+  {
+    linearCoords.x1[i] = linears[i].getX1();
+    linearCoords.y1[i] = linears[i].getY1();
+    linearCoords.x2[i] = linears[i].getX2();
+    linearCoords.y2[i] = linears[i].getY2();
+  }
+
+  circulars.clear();
+  circulars.reserve(stagedCirculars.size());
+  for (uint32_t i : circularOrder)
+  {
+    circulars.push_back(stagedCirculars[i].segment);
+  }
+
+  // Both arrays are sorted by cell, so each cell's range starts where the previous one ended
+  uint32_t linearIndex = 0;
+  uint32_t circularIndex = 0;
+  auto range = ranges.begin();
+  for (int i = 0; i < cellCount; ++i, ++range)
+  {
+    range->linearBegin = linearIndex;
+    while (linearIndex < linears.size() && stagedLinears[linearOrder[linearIndex]].cellIndex == i)
+    {
+      linearIndex++;
+    }
+    range->linearEnd = linearIndex;
+
+    range->circularBegin = circularIndex;
+    while (circularIndex < circulars.size() && stagedCirculars[circularOrder[circularIndex]].cellIndex == i)
+    {
+      circularIndex++;
+    }
+    range->circularEnd = circularIndex;
+  }
+
+  occupiedRows.fill(0);
+  for (int y = 0; y < HEIGHT; ++y)
+  {
+    for (int x = 0; x < WIDTH; ++x)
+    {
+      if (linearCount({x, y}) > 0 || circularCount({x, y}) > 0)
+      {
+        occupiedRows[y] |= uint64_t(1) << x;
+      }
+    }
+  }
+
+  for (int y = 0; y < HEIGHT; ++y)
+  {
+    for (int x = 0; x < WIDTH; ++x)
+    {
+      bool found = false;
+      for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, WIDTH - 1); ++nx)
+      {
+        for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, HEIGHT - 1); ++ny)
+        {
+          found = found || linearCount({nx, ny}) > 0;
+        }
+      }
+      linearsAround[{x, y}] = found;
+    }
+  }
+}
\ No newline at end of file
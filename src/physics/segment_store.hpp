@@ -0,0 +1,123 @@
+#pragma once
+
+#include "grid_segment_linear.hpp"
+#include "grid_segment_circular.hpp"
+#include "../utils.hpp"
+
+#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+// Tile and door segments packed into one contiguous array per segment type,
+// ordered by cell so that each cell owns an index range into both arrays.
+//
+// Segments are staged with addLinear/addCircular/addDoor and become visible to
+// queries once build() packs them. Door segments are kept apart from the tile
+// geometry so they can be dropped on reset without reloading the map.
+class SegmentStore
+{
+public:
+  using CellCoord = std::pair<int, int>;
+
+  // Cells are 44x25 plus one extra row and column for segments lying on the far border
+  static constexpr int WIDTH = 45;
+  static constexpr int HEIGHT = 26;
+
+  // Endpoints of the packed linear segments as separate arrays, for the
+  // vectorized sweep. Each array has COORD_PADDING extra zeroes at the end so
+  // full-width loads starting at any segment stay in bounds.
+  static constexpr int COORD_PADDING = 8;
+  struct LinearCoords
+  {
+    std::vector<Real> x1, y1, x2, y2;
+  };
+
+  // Staging
+  void clear();
+  void clearDoors();
+  // Tile segments must all be staged before the first door segment
+  void addLinear(const CellCoord &cell, const GridSegmentLinear &segment);
+  void addCircular(const CellCoord &cell, const GridSegmentCircular &segment);
+  std::size_t addDoor(const CellCoord &cell, const GridSegmentLinear &segment);
+  void build();
+
+  // Door segments are addressed by the id returned from addDoor
+  void setDoorActive(std::size_t doorId, bool active);
+
+  // Visit every linear then every circular segment of a cell. The visitor is
+  // called with the concrete segment type, so it can be a generic lambda.
+  template <typename Visitor>
+  void forEachInCell(const CellCoord &cell, Visitor &&visitor) const
+  {
+    forEachLinearInCell(cell, visitor);
+    forEachCircularInCell(cell, visitor);
+  }
+
+  template <typename Visitor>
+  void forEachLinearInCell(const CellCoord &cell, Visitor &&visitor) const
+  {
+    const CellRange &range = ranges[cell];
+    for (uint32_t i = range.linearBegin; i < range.linearEnd; ++i)
+    {
+      visitor(linears[i]);
+    }
+  }
+
+  template <typename Visitor>
+  void forEachCircularInCell(const CellCoord &cell, Visitor &&visitor) const
+  {
+    const CellRange &range = ranges[cell];
+    for (uint32_t i = range.circularBegin; i < range.circularEnd; ++i)
+    {
+      visitor(circulars[i]);
+    }
+  }
+
+  // Linears of consecutive cells in a row are adjacent, so a row span is one index range
+  uint32_t linearBegin(const CellCoord &cell) const { return ranges[cell].linearBegin; }
+  uint32_t linearEnd(const CellCoord &cell) const { return ranges[cell].linearEnd; }
+  const LinearCoords &getLinearCoords() const { return linearCoords; }
+
+  std::size_t linearCount(const CellCoord &cell) const { return ranges[cell].linearEnd - ranges[cell].linearBegin; }
+  std::size_t circularCount(const CellCoord &cell) const { return ranges[cell].circularEnd - ranges[cell].circularBegin; }
+  // Whether the cell holds any segment, active or not
+  bool hasSegments(const CellCoord &cell) const { return occupiedRows[cell.second] >> cell.first & 1; }
+  // Whether the cell or one of its eight neighbours holds linear segments
+  bool hasLinearsAround(const CellCoord &cell) const { return linearsAround[cell]; }
+
+private:
+  struct CellRange
+  {
+    uint32_t linearBegin = 0;
+    uint32_t linearEnd = 0;
+    uint32_t circularBegin = 0;
+    uint32_t circularEnd = 0;
+  };
+
+  template <typename T>
+  struct Staged
+  {
+    int cellIndex;
+    T segment;
+  };
+
+  static int cellIndex(const CellCoord &cell) { return cell.second * WIDTH + cell.first; }
+
+  // Staged segments in insertion order. Door segments follow the tile segments
+  // in stagedLinears, starting at tileLinearCount.
+  std::vector<Staged<GridSegmentLinear>> stagedLinears;
+  std::vector<Staged<GridSegmentCircular>> stagedCirculars;
+  std::size_t tileLinearCount = 0;
+
+  // Packed segments and their per-cell ranges
+  std::vector<GridSegmentLinear> linears;
+  std::vector<GridSegmentCircular> circulars;
+  LinearCoords linearCoords;
+  std::vector<uint32_t> doorSlots; // Door id -> index into linears
+  Grid<CellRange, WIDTH, HEIGHT> ranges;
+  static_assert(WIDTH <= 64, "A row of cells must fit in one occupancy mask");
+  std::array<uint64_t, HEIGHT> occupiedRows{}; // Bit x of row y is set when cell (x, y) holds segments
+  Grid<bool, WIDTH, HEIGHT> linearsAround;
+};
\ No newline at end of file
@@ -0,0 +1,318 @@
+#pragma once
+
+#include "grid_segment_linear.hpp"
+#include "grid_segment_circular.hpp"
+#include "../compiled_map.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#ifdef NCLONE_VERIFY_TILE_KERNELS
+#include <cstring>
+#include <stdexcept>
+#endif
+
+// The segment a tile contributes besides its orthogonal ones, with the tile's
+// geometry fixed at compile time from the CompiledMap tables. Orthogonal
+// segments depend on the neighbouring tiles and stay in the segment stores.
+//
+// Slopes and arcs, the shapes with such a segment, have a specialization that
+// repeats the operations of GridSegmentLinear and GridSegmentCircular on the
+// same values, so they give bitwise identical results, while the constant
+// extent and quadrant fold into the code. Slopes only answer closest points:
+// sweeps read every tile linear from the segment store, in LinearSweep. Arcs
+// answer both. Building with NCLONE_VERIFY_TILE_KERNELS checks every result
+// against the generic segment and throws std::logic_error on the first
+// difference.
+template <int TileId, TileShape Shape = CompiledMap::TILE_SHAPES[TileId]>
+class TileSegment
+{
+public:
+  // Empty, full, half and glitched tiles only have orthogonal segments
+  static constexpr bool IS_LINEAR = false;
+  static constexpr bool IS_CIRCULAR = false;
+};
+
+template <int TileId>
+class TileSegment<TileId, TileShape::Slope>
+{
+  static constexpr CompiledMap::TileDiagonal DIAGONAL = CompiledMap::TILE_SEGMENT_DIAG_MAP[TileId];
+  static constexpr Real PX = DIAGONAL.x2 - DIAGONAL.x1;
+  static constexpr Real PY = DIAGONAL.y2 - DIAGONAL.y1;
+  static constexpr Real SEG_LEN_SQ = PX * PX + PY * PY;
+
+public:
+  static constexpr bool IS_LINEAR = true;
+  static constexpr bool IS_CIRCULAR = false;
+
+  TileSegment(int xcell, int ycell)
+      : x1(xcell * 24 + DIAGONAL.x1), y1(ycell * 24 + DIAGONAL.y1)
+  {
+  }
+
+  bool isActive() const { return true; }
+
+  std::tuple<bool, Real, Real> getClosestPoint(Real xpos, Real ypos) const
+  {
+    Real dx = xpos - x1;
+    Real dy = ypos - y1;
+    Real u = (dx * PX + dy * PY) / SEG_LEN_SQ;
+    u = std::max(Real(0.0), std::min(Real(1.0), u));
+
+    Real a = x1 + u * PX;
+    Real b = y1 + u * PY;
+    bool isBackFacing = dy * PX - dx * PY < 0;
+
+    return verified(std::make_tuple(isBackFacing, a, b), xpos, ypos);
+  }
+
+  // The segment the map stores for this tile
+  GridSegmentLinear generic() const
+  {
+    return GridSegmentLinear({x1, y1}, {x1 + PX, y1 + PY});
+  }
+
+private:
+  std::tuple<bool, Real, Real> verified(std::tuple<bool, Real, Real> result,
+                                        [[maybe_unused]] Real xpos, [[maybe_unused]] Real ypos) const
+  {
+#ifdef NCLONE_VERIFY_TILE_KERNELS
+    auto reference = generic().getClosestPoint(xpos, ypos);
+    if (std::get<0>(result) != std::get<0>(reference) ||
+        std::memcmp(&std::get<1>(result), &std::get<1>(reference), sizeof(Real)) != 0 ||
+        std::memcmp(&std::get<2>(result), &std::get<2>(reference), sizeof(Real)) != 0)
+    {
+      throw std::logic_error("Tile slope kernel differs from the generic segment");
+    }
+#endif
+    return result;
+  }
+
+  Real x1, y1;
+};
+
+template <int TileId>
+class TileArcSegment
+{
+  static constexpr CompiledMap::TileArc ARC = CompiledMap::TILE_SEGMENT_CIRCULAR_MAP[TileId];
+  static constexpr Real RADIUS = 24.0;
+
+public:
+  static constexpr bool IS_LINEAR = false;
+  static constexpr bool IS_CIRCULAR = true;
+
+  TileArcSegment(int xcell, int ycell)
+      : xpos(xcell * 24 + ARC.xcenter), ypos(ycell * 24 + ARC.ycenter)
+  {
+  }
+
+  bool isActive() const { return true; }
+
+  std::tuple<bool, Real, Real> getClosestPoint(Real xposIn, Real yposIn) const
+  {
+    Real dx = xposIn - xpos;
+    Real dy = yposIn - ypos;
+
+    // This is true if position is closer from arc than its edges
+    if (dx * ARC.hor > 0 && dy * ARC.ver > 0)
+    {
+      Real dist = std::sqrt(dx * dx + dy * dy);
+      if (dist > 0)
+      {
+        Real a = xpos + RADIUS * dx / dist;
+        Real b = ypos + RADIUS * dy / dist;
+        bool isBackFacing = dist < RADIUS ? ARC.convex : !ARC.convex;
+        return verified(std::make_tuple(isBackFacing, a, b), xposIn, yposIn);
+      }
+    }
+
+    if (dx * ARC.hor > dy * ARC.ver)
+    {
+      return verified(std::make_tuple(false, xpos + RADIUS * ARC.hor, ypos), xposIn, yposIn);
+    }
+    return verified(std::make_tuple(false, xpos, ypos + RADIUS * ARC.ver), xposIn, yposIn);
+  }
+
+  // Earliest time the moving circle touches either end of the arc or the arc itself
+  Real intersectWithRay(Real xposIn, Real yposIn, Real dx, Real dy, Real radiusIn) const
+  {
+    Real time1 = timeVsPoint(xposIn, yposIn, dx, dy, xpos + RADIUS * ARC.hor, ypos, radiusIn);
+    Real time2 = timeVsPoint(xposIn, yposIn, dx, dy, xpos, ypos + RADIUS * ARC.ver, radiusIn);
+    Real time3 = timeVsArc(xposIn, yposIn, dx, dy, radiusIn);
+    return verifiedTime(std::min({time1, time2, time3}), xposIn, yposIn, dx, dy, radiusIn);
+  }
+
+  GridSegmentCircular generic() const
+  {
+    return GridSegmentCircular({xpos, ypos}, {ARC.hor, ARC.ver}, ARC.convex);
+  }
+
+private:
+  // Physics::getTimeOfIntersectionCircleVsCircle
+  static Real timeVsPoint(Real xposIn, Real yposIn, Real vx, Real vy, Real a, Real b, Real radiusIn)
+  {
+    Real dx = xposIn - a;
+    Real dy = yposIn - b;
+    Real distSq = dx * dx + dy * dy;
+    Real velSq = vx * vx + vy * vy;
+    Real dotProd = dx * vx + dy * vy;
+
+    if (distSq - radiusIn * radiusIn > 0)
+    {
+      Real radicand = dotProd * dotProd - velSq * (distSq - radiusIn * radiusIn);
+      if (velSq > Real(0.0001) && dotProd < 0 && radicand >= 0)
+      {
+        return (-dotProd - std::sqrt(radicand)) / velSq;
+      }
+      return 1.0;
+    }
+    return 0.0;
+  }
+
+  // Physics::getTimeOfIntersectionCircleVsArc, where multiplying by the
+  // quadrant's unit signs becomes a comparison
+  Real timeVsArc(Real xposIn, Real yposIn, Real vx, Real vy, Real radiusIn) const
+  {
+    Real dx = xposIn - xpos;
+    Real dy = yposIn - ypos;
+    Real distSq = dx * dx + dy * dy;
+    Real velSq = vx * vx + vy * vy;
+    Real dotProd = dx * vx + dy * vy;
+    Real radius1 = RADIUS + radiusIn;
+    Real radius2 = RADIUS - radiusIn;
+    Real t = 1.0;
+
+    if (distSq > radius1 * radius1)
+    {
+      Real radicand = dotProd * dotProd - velSq * (distSq - radius1 * radius1);
+      if (velSq > Real(0.0001) && dotProd < 0 && radicand >= 0)
+      {
+        t = (-dotProd - std::sqrt(radicand)) / velSq;
+      }
+    }
+    else if (distSq < radius2 * radius2)
+    {
+      Real radicand = dotProd * dotProd - velSq * (distSq - radius2 * radius2);
+      if (velSq > Real(0.0001))
+      {
+        t = std::min((-dotProd + std::sqrt(radicand)) / velSq, Real(1.0));
+      }
+    }
+    else
+    {
+      t = 0.0;
+    }
+
+    Real xhit = dx + t * vx;
+    Real yhit = dy + t * vy;
+    bool inQuadrant = (ARC.hor > 0 ? xhit > 0 : xhit < 0) && (ARC.ver > 0 ? yhit > 0 : yhit < 0);
+    return inQuadrant ? t : Real(1.0);
+  }
+
+  Real verifiedTime(Real result, [[maybe_unused]] Real xposIn, [[maybe_unused]] Real yposIn,
+                    [[maybe_unused]] Real dx, [[maybe_unused]] Real dy, [[maybe_unused]] Real radiusIn) const
+  {
+#ifdef NCLONE_VERIFY_TILE_KERNELS
+    Real reference = generic().intersectWithRay(xposIn, yposIn, dx, dy, radiusIn);
+    if (std::memcmp(&result, &reference, sizeof(Real)) != 0)
+    {
+      throw std::logic_error("Tile arc sweep kernel differs from the generic segment");
+    }
+#endif
+    return result;
+  }
+
+  std::tuple<bool, Real, Real> verified(std::tuple<bool, Real, Real> result,
+                                        [[maybe_unused]] Real xposIn, [[maybe_unused]] Real yposIn) const
+  {
+#ifdef NCLONE_VERIFY_TILE_KERNELS
+    auto reference = generic().getClosestPoint(xposIn, yposIn);
+    if (std::get<0>(result) != std::get<0>(reference) ||
+        std::memcmp(&std::get<1>(result), &std::get<1>(reference), sizeof(Real)) != 0 ||
+        std::memcmp(&std::get<2>(result), &std::get<2>(reference), sizeof(Real)) != 0)
+    {
+      throw std::logic_error("Tile arc kernel differs from the generic segment");
+    }
+#endif
+    return result;
+  }
+
+  Real xpos, ypos; // Center position
+};
+
+template <int TileId>
+class TileSegment<TileId, TileShape::QuarterMoon> : public TileArcSegment<TileId>
+{
+public:
+  using TileArcSegment<TileId>::TileArcSegment;
+};
+
+template <int TileId>
+class TileSegment<TileId, TileShape::QuarterPipe> : public TileArcSegment<TileId>
+{
+public:
+  using TileArcSegment<TileId>::TileArcSegment;
+};
+
+// Visit the tile segment of a cell from its tile id, with the specialization
+// of that id. The segment stores visit the same segments in the same order:
+// a cell's slope comes first among its linears and a cell holds at most one
+// arc, always from its own tile.
+class TileSegments
+{
+public:
+  using CellCoord = std::pair<int, int>;
+
+  static bool hasLinear(int tileId) { return shapeOf(tileId) == TileShape::Slope; }
+  static bool hasCircular(int tileId)
+  {
+    TileShape shape = shapeOf(tileId);
+    return shape == TileShape::QuarterMoon || shape == TileShape::QuarterPipe;
+  }
+
+  template <typename Visitor>
+  static void forEachLinearInCell(int tileId, const CellCoord &cell, Visitor &&visitor)
+  {
+    if (hasLinear(tileId))
+    {
+      dispatch<true>(tileId, cell, visitor, std::make_integer_sequence<int, CompiledMap::TILE_TYPE_COUNT>());
+    }
+  }
+
+  template <typename Visitor>
+  static void forEachCircularInCell(int tileId, const CellCoord &cell, Visitor &&visitor)
+  {
+    if (hasCircular(tileId))
+    {
+      dispatch<false>(tileId, cell, visitor, std::make_integer_sequence<int, CompiledMap::TILE_TYPE_COUNT>());
+    }
+  }
+
+private:
+  static TileShape shapeOf(int tileId)
+  {
+    return tileId >= 0 && tileId < CompiledMap::TILE_TYPE_COUNT ? CompiledMap::TILE_SHAPES[tileId] : TileShape::Empty;
+  }
+
+  template <int TileId, bool Linear, typename Visitor>
+  static void visit(const CellCoord &cell, Visitor &visitor)
+  {
+    using Segment = TileSegment<TileId>;
+    if constexpr (Linear ? Segment::IS_LINEAR : Segment::IS_CIRCULAR)
+    {
+      visitor(Segment(cell.first, cell.second));
+    }
+  }
+
+  // One entry per tile id, so the id selects its specialization in one jump
+  template <bool Linear, typename Visitor, int... TileIds>
+  static void dispatch(int tileId, const CellCoord &cell, Visitor &visitor, std::integer_sequence<int, TileIds...>)
+  {
+    static constexpr std::array<void (*)(const CellCoord &, Visitor &), sizeof...(TileIds)> table = {
+        &visit<TileIds, Linear, Visitor>...};
+    table[tileId](cell, visitor);
+  }
+};
\ No newline at end of file
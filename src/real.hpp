@@ -0,0 +1,12 @@
+#pragma once
+
+// Floating point type of the simulation core: positions, velocities, segment
+// geometry and every physics routine. The default float build is the fast
+// one. Building with NCLONE_DOUBLE_PRECISION gives a reference variant that
+// computes in double like the original Python simulator, to check trajectory
+// parity against it.
+#ifdef NCLONE_DOUBLE_PRECISION
+using Real = double;
+#else
+using Real = float;
+#endif
\ No newline at end of file
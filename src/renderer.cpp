@@ -6,7 +6,6 @@
 #include "entities/drone_base.hpp"
 #include "entities/laser.hpp"
 #include "ninja.hpp"
-#include "physics/segment.hpp"
 #include "entities/door_regular.hpp"
 #include <cmath>
 #include <filesystem>
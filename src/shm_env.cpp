@@ -0,0 +1,160 @@
+#include "shm_env.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace ShmEnv
+{
+  namespace
+  {
+    constexpr size_t ALIGNMENT = 64;
+    constexpr int SPIN_ITERATIONS = 2000;
+
+    size_t aligned(size_t size)
+    {
+      return (size + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+
+    std::runtime_error systemError(const std::string &what, const std::string &name)
+    {
+      return std::runtime_error(what + " " + name + ": " + std::strerror(errno));
+    }
+
+    // Removes the segment of that name if it was left behind by a server that
+    // was killed before it could remove it, which its header tells by a
+    // recorded server pid that is no longer alive. Returns whether it did;
+    // errno is left alone when it did not.
+    bool removeIfStale(const std::string &name)
+    {
+      int savedErrno = errno;
+      bool stale = false;
+      int fd = shm_open(name.c_str(), O_RDONLY, 0);
+      struct stat status;
+      if (fd >= 0 && fstat(fd, &status) == 0 && static_cast<size_t>(status.st_size) >= sizeof(Header))
+      {
+        void *mapped = mmap(nullptr, sizeof(Header), PROT_READ, MAP_SHARED, fd, 0);
+        if (mapped != MAP_FAILED)
+        {
+          // A starting server has not recorded its pid yet
+          uint32_t pid = static_cast<const Header *>(mapped)->serverPid;
+          stale = pid != 0 && !isProcessAlive(pid);
+          munmap(mapped, sizeof(Header));
+        }
+      }
+      if (fd >= 0)
+      {
+        close(fd);
+      }
+      if (stale)
+      {
+        shm_unlink(name.c_str());
+      }
+      errno = savedErrno;
+      return stale;
+    }
+  }
+
+  Layout::Layout(const Dimensions &dims, uint8_t *base)
+      : dims(dims), base(base)
+  {
+    headerSize = aligned(sizeof(Header));
+    mapOffset = aligned(sizeof(Slot));
+    entriesOffset = mapOffset + aligned(dims.maxMapSize);
+    actionsOffset = aligned(sizeof(Request));
+    observationsOffset = actionsOffset + aligned(dims.envsPerSlot * 2 * sizeof(int32_t));
+    rewardsOffset = observationsOffset + aligned(static_cast<size_t>(dims.envsPerSlot) * dims.observationSize * sizeof(float));
+    donesOffset = rewardsOffset + aligned(dims.envsPerSlot * sizeof(float));
+    entrySize = donesOffset + aligned(dims.envsPerSlot);
+    slotSize = entriesOffset + dims.ringDepth * entrySize;
+  }
+
+  SharedMemory::SharedMemory(const std::string &nameIn, size_t createSize)
+      : name(nameIn.empty() || nameIn[0] != '/' ? "/" + nameIn : nameIn),
+        owner(createSize > 0)
+  {
+    int fd = owner ? shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600) : shm_open(name.c_str(), O_RDWR, 0);
+    if (fd < 0 && owner && errno == EEXIST && removeIfStale(name))
+    {
+      fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    }
+    if (fd < 0)
+    {
+      throw systemError(owner ? "Could not create shared memory" : "Could not open shared memory", name);
+    }
+
+    struct stat status;
+    if (owner ? ftruncate(fd, createSize) != 0 : fstat(fd, &status) != 0)
+    {
+      auto error = systemError("Could not size shared memory", name);
+      close(fd);
+      if (owner)
+      {
+        shm_unlink(name.c_str());
+      }
+      throw error;
+    }
+    length = owner ? createSize : status.st_size;
+
+    void *mapped = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED)
+    {
+      auto error = systemError("Could not map shared memory", name);
+      if (owner)
+      {
+        shm_unlink(name.c_str());
+      }
+      throw error;
+    }
+    base = static_cast<uint8_t *>(mapped);
+  }
+
+  SharedMemory::~SharedMemory()
+  {
+    munmap(base, length);
+    if (owner)
+    {
+      shm_unlink(name.c_str());
+    }
+  }
+
+  void futexWait(const std::atomic<uint32_t> &word, uint32_t expected, int timeoutMs)
+  {
+    timespec timeout{timeoutMs / 1000, timeoutMs % 1000 * 1000000L};
+    // Not FUTEX_PRIVATE: the word is shared with other processes
+    syscall(SYS_futex, reinterpret_cast<const uint32_t *>(&word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+  }
+
+  void futexWakeAll(std::atomic<uint32_t> &word)
+  {
+    syscall(SYS_futex, reinterpret_cast<uint32_t *>(&word), FUTEX_WAKE, INT32_MAX, nullptr, nullptr, 0);
+  }
+
+  bool waitForChange(const std::atomic<uint32_t> &word, uint32_t value, int timeoutMs)
+  {
+    for (int i = 0; i < SPIN_ITERATIONS; ++i)
+    {
+      if (word.load(std::memory_order_acquire) != value)
+      {
+        return true;
+      }
+    }
+    futexWait(word, value, timeoutMs);
+    return word.load(std::memory_order_acquire) != value;
+  }
+
+  bool isProcessAlive(uint32_t pid)
+  {
+    return kill(pid, 0) == 0 || errno != ESRCH;
+  }
+}
\ No newline at end of file
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Shared memory protocol between EnvServer, which hosts simulations in one
+// process, and the EnvClients of other processes (Linux only). The segment
+// holds a header and a number of slots, each used by at most one client:
+//
+//   Header | Slot 0: Slot, map area, ring of ringDepth entries | Slot 1 ...
+//
+// A ring entry holds a Request header followed by the actions, observations,
+// rewards and dones of the slot's simulations. The client writes entry
+// requestSeq % ringDepth and bumps requestSeq; the server thread of the slot
+// runs it, writes the results into the same entry and bumps responseSeq.
+// Both sequence numbers are futex words, so either side sleeps in the kernel
+// until the other one makes progress, and no data is ever serialized.
+namespace ShmEnv
+{
+  constexpr uint32_t MAGIC = 0x4e434c4e;
+  constexpr uint32_t VERSION = 1;
+  constexpr size_t ERROR_SIZE = 256;
+
+  static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+                "futex words must be plain 32 bit integers");
+
+  enum class Command : uint32_t
+  {
+    Step,
+    Reset,
+    LoadMap
+  };
+
+  struct Dimensions
+  {
+    uint32_t slotCount;
+    uint32_t envsPerSlot;
+    uint32_t ringDepth;
+    uint32_t observationSize;
+    uint32_t maxMapSize;
+  };
+
+  struct Header
+  {
+    std::atomic<uint32_t> magic; // Stored last, once the server is serving
+    uint32_t version;
+    uint32_t serverPid;
+    Dimensions dims;
+    std::atomic<uint32_t> stopping;
+  };
+
+  struct Slot
+  {
+    alignas(64) std::atomic<uint32_t> owner; // Pid of the client using the slot, 0 when free
+    alignas(64) std::atomic<uint32_t> requestSeq;
+    alignas(64) std::atomic<uint32_t> responseSeq;
+  };
+
+  struct Request
+  {
+    Command command;
+    int32_t index;    // Reset and LoadMap: simulation of the slot, or -1 for all of them
+    uint32_t mapSize; // LoadMap: bytes of level data in the slot's map area
+    uint32_t failed;  // Set by the server, with the exception message in error
+    char error[ERROR_SIZE];
+  };
+
+  // Offsets of the parts of a segment with the given dimensions. Without a
+  // base address, only size() is meaningful.
+  class Layout
+  {
+  public:
+    explicit Layout(const Dimensions &dims, uint8_t *base = nullptr);
+
+    size_t size() const { return headerSize + dims.slotCount * slotSize; }
+    const Dimensions &getDimensions() const { return dims; }
+
+    Header &header() const { return *reinterpret_cast<Header *>(base); }
+    Slot &slot(int slot) const { return *reinterpret_cast<Slot *>(slotBase(slot)); }
+    uint8_t *mapData(int slot) const { return slotBase(slot) + mapOffset; }
+    Request &request(int slot, uint32_t seq) const { return *reinterpret_cast<Request *>(entry(slot, seq)); }
+    int32_t *actions(int slot, uint32_t seq) const { return reinterpret_cast<int32_t *>(entry(slot, seq) + actionsOffset); }
+    float *observations(int slot, uint32_t seq) const { return reinterpret_cast<float *>(entry(slot, seq) + observationsOffset); }
+    float *rewards(int slot, uint32_t seq) const { return reinterpret_cast<float *>(entry(slot, seq) + rewardsOffset); }
+    uint8_t *dones(int slot, uint32_t seq) const { return entry(slot, seq) + donesOffset; }
+
+  private:
+    uint8_t *slotBase(int slot) const { return base + headerSize + slot * slotSize; }
+    uint8_t *entry(int slot, uint32_t seq) const { return slotBase(slot) + entriesOffset + seq % dims.ringDepth * entrySize; }
+
+    Dimensions dims;
+    uint8_t *base;
+    size_t headerSize;
+    size_t mapOffset;
+    size_t entriesOffset;
+    size_t actionsOffset;
+    size_t observationsOffset;
+    size_t rewardsOffset;
+    size_t donesOffset;
+    size_t entrySize;
+    size_t slotSize;
+  };
+
+  // A POSIX shared memory segment mapped into this process. With a size, a
+  // new segment is created and removed again on destruction, replacing one
+  // left behind by a server that died; without one, an existing segment is
+  // opened. Names get the leading slash POSIX wants.
+  class SharedMemory
+  {
+  public:
+    SharedMemory(const std::string &name, size_t createSize = 0);
+    ~SharedMemory();
+
+    SharedMemory(const SharedMemory &) = delete;
+    SharedMemory &operator=(const SharedMemory &) = delete;
+
+    uint8_t *data() const { return base; }
+    size_t size() const { return length; }
+
+  private:
+    std::string name;
+    uint8_t *base = nullptr;
+    size_t length = 0;
+    bool owner;
+  };
+
+  // Sleep while word still holds expected, for at most timeoutMs. Returns
+  // early on wakes and signals, so callers recheck their condition.
+  void futexWait(const std::atomic<uint32_t> &word, uint32_t expected, int timeoutMs);
+  void futexWakeAll(std::atomic<uint32_t> &word);
+
+  // Spin briefly and then sleep until word differs from value, or timeoutMs passed
+  bool waitForChange(const std::atomic<uint32_t> &word, uint32_t value, int timeoutMs);
+
+  bool isProcessAlive(uint32_t pid);
+}
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "sim_wrapper.hpp"
+#include "observation.hpp"
 #include "ninja.hpp"
 #include "entities/entity.hpp"
 #include <SFML/Graphics.hpp>
@@ -26,6 +27,16 @@ void SimWrapper::tick(int horInput, int jumpInput)
   sim->tick(horInput, jumpInput);
 }
 
+void SimWrapper::snapshot(SimulationState &state) const
+{
+  sim->snapshot(state);
+}
+
+void SimWrapper::restore(const SimulationState &state)
+{
+  sim->restore(state);
+}
+
 bool SimWrapper::hasWon() const
 {
   return sim->getNinja()->hasWon();
@@ -73,97 +84,29 @@ int SimWrapper::getSimFrame() const
   return sim->getFrame();
 }
 
-std::vector<float> SimWrapper::getNinjaState() const
+std::pair<uint64_t, uint64_t> SimWrapper::getNeighbourhoodCacheStats() const
 {
-  auto ninja = sim->getNinja();
-  std::vector<float> state;
-  state.reserve(10);
-
-  // Match Python implementation order
-  state.push_back(ninja->xpos / 1056.0f);                                // Position normalized by screen width
-  state.push_back(ninja->ypos / 600.0f);                                 // Position normalized by screen height
-  state.push_back((ninja->xspeed / ninja->MAX_HOR_SPEED + 1.0f) / 2.0f); // Speed normalized to [0,1]
-  state.push_back((ninja->yspeed / ninja->MAX_HOR_SPEED + 1.0f) / 2.0f);
-  state.push_back(ninja->airborn ? 1.0f : 0.0f);
-  state.push_back(ninja->walled ? 1.0f : 0.0f);
-  state.push_back(static_cast<float>(ninja->jumpDuration) / ninja->MAX_JUMP_DURATION);
-  state.push_back((ninja->appliedGravity - ninja->GRAVITY_JUMP) / (ninja->GRAVITY_FALL - ninja->GRAVITY_JUMP));
-  state.push_back((ninja->appliedDrag - ninja->DRAG_SLOW) / (ninja->DRAG_REGULAR - ninja->DRAG_SLOW));
-  state.push_back((ninja->appliedFriction - ninja->FRICTION_WALL) / (ninja->FRICTION_GROUND - ninja->FRICTION_WALL));
+  const auto &stats = sim->getNeighbourhoodCacheStats();
+  return {stats.hits, stats.misses};
+}
+
+std::vector<uint64_t> SimWrapper::getCollisionPassHistogram() const
+{
+  const auto &histogram = sim->getCollisionPassHistogram();
+  return std::vector<uint64_t>(histogram.begin(), histogram.end());
+}
 
+std::vector<float> SimWrapper::getNinjaState() const
+{
+  std::vector<float> state(Observation::NINJA_STATE_SIZE);
+  Observation::writeNinjaState(*sim, state.data());
   return state;
 }
 
 std::vector<float> SimWrapper::getEntityStates(bool onlyExitAndSwitch) const
 {
-  std::vector<float> state;
-
-  if (onlyExitAndSwitch)
-  {
-    // Just return exit switch active and exit door active states
-    auto entities = sim->getEntitiesByType(3); // Exit type
-    if (!entities.empty())
-    {
-      auto exitDoor = entities[0];
-      state.push_back(exitDoor->isActive() ? 1.0f : 0.0f);
-    }
-
-    entities = sim->getEntitiesByType(4); // Switch type
-    if (!entities.empty())
-    {
-      auto exitSwitch = entities[0];
-      state.push_back(exitSwitch->isActive() ? 1.0f : 0.0f);
-    }
-    return state;
-  }
-
-  // Constants from Python implementation
-  const int MAX_ATTRIBUTES = 4;
-  const std::unordered_map<int, int> MAX_COUNTS = {
-      {1, 128}, // Toggle Mine
-      {2, 128}, // Gold
-      {3, 1},   // Exit
-      {5, 32},  // Door Regular
-      {6, 32},  // Door Locked
-      {8, 32},  // Door Trap
-      {10, 32}, // Launch Pad
-      {11, 32}, // One Way Platform
-      {14, 32}, // Drone Zap
-      {17, 32}, // Bounce Block
-      {20, 32}, // Thwump
-      {24, 32}, // Boost Pad
-      {25, 32}, // Death Ball
-      {26, 32}, // Mini Drone
-      {28, 32}  // Shove Thwump
-  };
-
-  // Process each entity type
-  for (const auto &[entityType, maxCount] : MAX_COUNTS)
-  {
-    auto entities = sim->getEntitiesByType(entityType);
-    state.push_back(static_cast<float>(entities.size()) / maxCount);
-
-    // Process each entity up to maxCount
-    for (int i = 0; i < maxCount; i++)
-    {
-      if (i < entities.size())
-      {
-        auto entityState = entities[i]->getState(false);
-        // Pad with zeros if needed
-        while (entityState.size() < MAX_ATTRIBUTES)
-        {
-          entityState.push_back(0.0f);
-        }
-        state.insert(state.end(), entityState.begin(), entityState.begin() + MAX_ATTRIBUTES);
-      }
-      else
-      {
-        // Add padding for non-existent entity
-        state.insert(state.end(), MAX_ATTRIBUTES, 0.0f);
-      }
-    }
-  }
-
+  std::vector<float> state(Observation::maxEntityStateSize(onlyExitAndSwitch));
+  state.resize(Observation::writeEntityStates(*sim, onlyExitAndSwitch, state.data()));
   return state;
 }
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include <vector>
 #include "simulation.hpp"
+#include "simulation_state.hpp"
 #include "renderer.hpp"
 #include "ninja.hpp"
 
@@ -17,6 +18,10 @@ public:
   void reset();
   void tick(int horInput, int jumpInput);
 
+  // Branching search support, see Simulation::snapshot
+  void snapshot(SimulationState &state) const;
+  void restore(const SimulationState &state);
+
   // State getters
   bool hasWon() const;
   bool hasDied() const;
@@ -31,6 +36,10 @@ public:
   bool exitSwitchActivated() const;
   std::pair<float, float> getExitSwitchPosition() const;
   std::pair<float, float> getExitDoorPosition() const;
+  // Hits and misses of the ninja's entity neighbourhood cache since construction
+  std::pair<uint64_t, uint64_t> getNeighbourhoodCacheStats() const;
+  // Ticks since construction that used 1, 2, 3 and 4 ninja collision passes
+  std::vector<uint64_t> getCollisionPassHistogram() const;
 
   // New state getters
   std::vector<float> getNinjaState() const;
@@ -4,352 +4,165 @@
 #include "entities/entity.hpp"
 #include "physics/grid_segment_linear.hpp"
 #include "physics/grid_segment_circular.hpp"
-#include "entities/toggle_mine.hpp"
-#include "entities/gold.hpp"
-#include "entities/exit_door.hpp"
-#include "entities/exit_switch.hpp"
-#include "entities/door_regular.hpp"
-#include "entities/door_locked.hpp"
-#include "entities/door_trap.hpp"
-#include "entities/launch_pad.hpp"
-#include "entities/one_way_platform.hpp"
-#include "entities/drone_zap.hpp"
-#include "entities/drone_chaser.hpp"
-#include "entities/bounce_block.hpp"
-#include "entities/thwump.hpp"
-#include "entities/laser.hpp"
-#include "entities/boost_pad.hpp"
-#include "entities/death_ball.hpp"
-#include "entities/mini_drone.hpp"
-#include "entities/shove_thwump.hpp"
+#include "entities/entity_pool.hpp"
+#include "simulation_state.hpp"
 #include <cmath>
 #include <algorithm>
-
-// Initialize static tile map constants
-const std::unordered_map<int, std::array<int, 12>> Simulation::TILE_GRID_EDGE_MAP = {
-    {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}, // Empty tile
-    {1, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}}, // Full tile
-    {2, {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0}}, // Half tiles
-    {3, {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1}},
-    {4, {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1}},
-    {5, {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0}},
-    {6, {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0}}, // 45 degree slopes
-    {7, {1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1}},
-    {8, {0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1}},
-    {9, {1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1}},
-    {10, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}}, // Quarter moons
-    {11, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {12, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {13, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {14, {1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1, 0}}, // Quarter pipes
-    {15, {1, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 1}},
-    {16, {0, 1, 1, 0, 1, 1, 0, 1, 1, 0, 1, 1}},
-    {17, {1, 0, 0, 1, 1, 1, 1, 1, 1, 0, 0, 1}},
-    {18, {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0}}, // Short mild slopes
-    {19, {1, 1, 1, 1, 0, 0, 1, 0, 0, 0, 1, 0}},
-    {20, {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1}},
-    {21, {0, 0, 1, 1, 1, 1, 0, 1, 0, 0, 0, 1}},
-    {22, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}}, // Raised mild slopes
-    {23, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {24, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {25, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {26, {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0}}, // Short steep slopes
-    {27, {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1}},
-    {28, {0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 1, 1}},
-    {29, {1, 0, 0, 0, 1, 0, 1, 1, 1, 1, 0, 0}},
-    {30, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}}, // Raised steep slopes
-    {31, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {32, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {33, {1, 1, 0, 0, 1, 1, 1, 1, 0, 0, 1, 1}},
-    {34, {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}, // Glitched tiles
-    {35, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {36, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0}},
-    {37, {0, 0, 0, 0, 0, 0, 1, 1, 0, 0, 0, 0}}};
-
-const std::unordered_map<int, std::array<int, 12>> Simulation::TILE_SEGMENT_ORTHO_MAP = {
-    {0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}},     // Empty tile
-    {1, {-1, -1, 0, 0, 1, 1, -1, -1, 0, 0, 1, 1}}, // Full tile
-    {2, {-1, -1, 1, 1, 0, 0, -1, 0, 0, 0, 1, 0}},  // Half tiles
-    {3, {0, -1, 0, 0, 0, 1, 0, 0, -1, -1, 1, 1}},
-    {4, {0, 0, -1, -1, 1, 1, 0, -1, 0, 0, 0, 1}},
-    {5, {-1, 0, 0, 0, 1, 0, -1, -1, 1, 1, 0, 0}},
-    {6, {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}}, // 45 degree slopes
-    {7, {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {8, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1}},
-    {9, {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0}},
-    {10, {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}}, // Quarter moons
-    {11, {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {12, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1}},
-    {13, {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0}},
-    {14, {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}}, // Quarter pipes
-    {15, {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {16, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1}},
-    {17, {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0}},
-    {18, {-1, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0}}, // Short mild slopes
-    {19, {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0}},
-    {20, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 1}},
-    {21, {0, 0, 0, 0, 1, 1, 0, -1, 0, 0, 0, 0}},
-    {22, {-1, -1, 0, 0, 0, 0, -1, -1, 0, 0, 1, 0}}, // Raised mild slopes
-    {23, {-1, -1, 0, 0, 0, 0, -1, 0, 0, 0, 1, 1}},
-    {24, {0, 0, 0, 0, 1, 1, 0, -1, 0, 0, 1, 1}},
-    {25, {0, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 1}},
-    {26, {-1, 0, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}}, // Short steep slopes
-    {27, {0, -1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {28, {0, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1}},
-    {29, {0, 0, 0, 0, 1, 0, -1, -1, 0, 0, 0, 0}},
-    {30, {-1, -1, 0, 0, 1, 0, -1, -1, 0, 0, 0, 0}}, // Raised steep slopes
-    {31, {-1, -1, 0, 0, 0, 1, 0, 0, 0, 0, 1, 1}},
-    {32, {0, -1, 0, 0, 1, 1, 0, 0, 0, 0, 1, 1}},
-    {33, {-1, 0, 0, 0, 1, 1, -1, -1, 0, 0, 0, 0}},
-    {34, {-1, -1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}}, // Glitched tiles
-    {35, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1}},
-    {36, {0, 0, 0, 0, 1, 1, 0, 0, 0, 0, 0, 0}},
-    {37, {0, 0, 0, 0, 0, 0, -1, -1, 0, 0, 0, 0}}};
-
-const std::unordered_map<int, std::tuple<std::pair<int, int>, std::pair<int, int>, bool>> Simulation::TILE_SEGMENT_CIRCULAR_MAP = {
-    {10, {{0, 0}, {1, 1}, true}}, // Quarter moons
-    {11, {{24, 0}, {-1, 1}, true}},
-    {12, {{24, 24}, {-1, -1}, true}},
-    {13, {{0, 24}, {1, -1}, true}},
-    {14, {{24, 24}, {-1, -1}, false}}, // Quarter pipes
-    {15, {{0, 24}, {1, -1}, false}},
-    {16, {{0, 0}, {1, 1}, false}},
-    {17, {{24, 0}, {-1, 1}, false}}};
-
-const std::unordered_map<int, std::tuple<std::pair<int, int>, std::pair<int, int>>> Simulation::TILE_SEGMENT_DIAG_MAP = {
-    {6, {{0, 24}, {24, 0}}}, // 45 degree slopes
-    {7, {{0, 0}, {24, 24}}},
-    {8, {{24, 0}, {0, 24}}},
-    {9, {{24, 24}, {0, 0}}},
-    {18, {{0, 12}, {24, 0}}}, // Short mild slopes
-    {19, {{0, 0}, {24, 12}}},
-    {20, {{24, 12}, {0, 24}}},
-    {21, {{24, 24}, {0, 12}}},
-    {22, {{0, 24}, {24, 12}}}, // Raised mild slopes
-    {23, {{0, 12}, {24, 24}}},
-    {24, {{24, 0}, {0, 12}}},
-    {25, {{24, 12}, {0, 0}}},
-    {26, {{0, 24}, {12, 0}}}, // Short steep slopes
-    {27, {{12, 0}, {24, 24}}},
-    {28, {{24, 0}, {12, 24}}},
-    {29, {{12, 24}, {0, 0}}},
-    {30, {{12, 24}, {24, 0}}}, // Raised steep slopes
-    {31, {{0, 0}, {12, 24}}},
-    {32, {{12, 0}, {0, 24}}},
-    {33, {{24, 24}, {12, 0}}}};
+#include <type_traits>
 
 Simulation::Simulation(const SimConfig &sc)
-    : frame(0), simConfig(sc), ninja(nullptr)
+    : frame(0), simConfig(sc), ninja(nullptr), entityPools(std::make_unique<EntityPools>())
 {
 }
 
+Simulation::~Simulation() = default;
+
 void Simulation::resetMapEntityData()
 {
-  gridEntity.clear();
-  entityDic.clear();
-
-  // Initialize grid cells
-  for (int x = 0; x < 44; ++x)
+  entityPools->forEach([](auto &pool)
+                       { pool.clear(); });
+  invalidateEntityNeighbourhood();
+
+  // Door segments and edges are recreated along with their entities
+  doorSegments.clear();
+  doorHorGridEdges.fill(0);
+  doorVerGridEdges.fill(0);
+  horEdgeBits = map->getHorEdgeBits();
+  verEdgeBits = map->getVerEdgeBits();
+
+  // Empty grid cells
+  for (auto &cellEntities : gridEntity)
   {
-    for (int y = 0; y < 25; ++y)
-    {
-      gridEntity[{x, y}] = EntityList();
-    }
+    cellEntities.clear();
   }
 
-  // Initialize entity type lists
-  for (int i = 1; i < 29; ++i)
+  // Empty entity type lists
+  for (auto &typeEntities : entityDic)
   {
-    entityDic[i] = EntityList();
+    typeEntities.clear();
   }
 }
 
-void Simulation::resetMapTileData()
+void Simulation::load(const std::vector<uint8_t> &mapData)
 {
-  segmentDic.clear();
-  horGridEdgeDic.clear();
-  verGridEdgeDic.clear();
-  horSegmentDic.clear();
-  verSegmentDic.clear();
-
-  // Initialize segment dictionary
-  for (int x = 0; x < 45; ++x)
-  {
-    for (int y = 0; y < 26; ++y)
-    {
-      segmentDic[{x, y}] = SegmentList();
-    }
-  }
-
-  // Initialize grid edges
-  for (int x = 0; x < 89; ++x)
-  {
-    for (int y = 0; y < 51; ++y)
-    {
-      horGridEdgeDic[{x, y}] = (y == 0 || y == 50) ? 1 : 0;
-      verGridEdgeDic[{x, y}] = (x == 0 || x == 88) ? 1 : 0;
-      horSegmentDic[{x, y}] = 0;
-      verSegmentDic[{x, y}] = 0;
-    }
-  }
+  load(CompiledMap::getShared(mapData));
 }
 
-void Simulation::load(const std::vector<uint8_t> &mapData)
+void Simulation::load(std::shared_ptr<const CompiledMap> compiledMap)
 {
-  this->mapData = mapData;
-  resetMapTileData();
-  loadMapTiles();
+  map = std::move(compiledMap);
+  initialState.reset();
   reset();
 }
 
 void Simulation::reset()
 {
+  if (initialState)
+  {
+    restore(*initialState);
+    return;
+  }
+
   frame = 0;
   collisionLog.clear();
   ninja.reset();
   resetMapEntityData();
   loadMapEntities();
+
+  initialState = std::make_unique<SimulationState>();
+  snapshot(*initialState);
 }
 
-void Simulation::loadMapTiles()
+void Simulation::snapshot(SimulationState &state) const
 {
-  // Extract tile data from map data
-  auto tileData = std::vector<uint8_t>(mapData.begin() + 184, mapData.begin() + 1150);
-
-  // Map each tile to its cell
-  for (int x = 0; x < 42; ++x)
+  if (state.map != map)
   {
-    for (int y = 0; y < 23; ++y)
-    {
-      tileDic[{x + 1, y + 1}] = tileData[x + y * 42];
-    }
+    state.map = map;
   }
+  state.frame = frame;
+  state.collisionLog = collisionLog;
+  state.ninja = *ninja;
+  state.entityPools = *entityPools;
+  state.entityPools.rebase(*entityPools, nullptr);
+}
 
-  // Set outer edges to tile type 1 (full tile)
-  for (int x = 0; x < 44; ++x)
-  {
-    tileDic[{x, 0}] = 1;
-    tileDic[{x, 24}] = 1;
-  }
-  for (int y = 0; y < 25; ++y)
+void Simulation::restore(const SimulationState &state)
+{
+  if (!map || state.map != map)
   {
-    tileDic[{0, y}] = 1;
-    tileDic[{43, y}] = 1;
+    throw std::invalid_argument("Simulation state was taken on another map");
   }
 
-  // This loop makes the inventory of grid edges and orthogonal linear segments,
-  // and initiates non-orthogonal linear segments and circular segments.
-  for (const auto &[coord, tileId] : tileDic)
-  {
-    auto [xcoord, ycoord] = coord;
-    int xtl = xcoord * 24;
-    int ytl = ycoord * 24;
-
-    // Assign every grid edge and orthogonal linear segment to the dictionaries
-    auto gridEdgeIter = TILE_GRID_EDGE_MAP.find(tileId);
-    auto segmentOrthoIter = TILE_SEGMENT_ORTHO_MAP.find(tileId);
-
-    if (gridEdgeIter != TILE_GRID_EDGE_MAP.end() && segmentOrthoIter != TILE_SEGMENT_ORTHO_MAP.end())
+  // Empty every cell that currently holds an entity. Only pool entities live
+  // in the grid, so each cell is refilled below from the restored slots.
+  entityPools->forEach([&](auto &pool)
+                       {
+    for (auto &entity : pool.entities)
     {
-      const auto &gridEdgeList = gridEdgeIter->second;
-      const auto &segmentOrthoList = segmentOrthoIter->second;
-
-      // Process horizontal edges and segments
-      for (int y = 0; y < 3; ++y)
-      {
-        for (int x = 0; x < 2; ++x)
-        {
-          CellCoord pos{2 * xcoord + x, 2 * ycoord + y};
-          horGridEdgeDic[pos] = (horGridEdgeDic[pos] + gridEdgeList[2 * y + x]) % 2;
-          horSegmentDic[pos] += segmentOrthoList[2 * y + x];
-        }
-      }
+      gridEntity[entity.getCell()].clear();
+    } });
+
+  // Pools never grow after loading, so copying the entities back assigns
+  // element by element into the same storage, and the type lists still point
+  // at the right entities. The active lists and links between entities of
+  // the state point into its own copies and are moved over to ours.
+  frame = state.frame;
+  collisionLog = state.collisionLog;
+  *ninja = *state.ninja;
+  *entityPools = state.entityPools;
+  entityPools->rebase(state.entityPools, this);
+  invalidateEntityNeighbourhood();
+
+  entityPools->forEach([&](auto &pool)
+                       {
+    for (auto &entity : pool.entities)
+    {
+      size_t slot = entity.getGridSlot();
+      if (slot == Entity::NOT_IN_GRID)
+        continue;
 
-      // Process vertical edges and segments
-      for (int x = 0; x < 3; ++x)
+      auto &cellList = gridEntity[entity.getCell()];
+      if (cellList.size() <= slot)
       {
-        for (int y = 0; y < 2; ++y)
-        {
-          CellCoord pos{2 * xcoord + x, 2 * ycoord + y};
-          verGridEdgeDic[pos] = (verGridEdgeDic[pos] + gridEdgeList[2 * x + y + 6]) % 2;
-          verSegmentDic[pos] += segmentOrthoList[2 * x + y + 6];
-        }
+        cellList.resize(slot + 1);
       }
-    }
-
-    // Initiate non-orthogonal linear and circular segments
-    auto diagIter = TILE_SEGMENT_DIAG_MAP.find(tileId);
-    if (diagIter != TILE_SEGMENT_DIAG_MAP.end())
+      cellList[slot] = &entity;
+    } });
+
+  // Each closed door accounts for one count on each of its grid edges
+  entityPools->forEach([](auto &pool)
+                       {
+    using T = typename std::decay_t<decltype(pool)>::Type;
+    if constexpr (std::is_base_of_v<DoorBase, T>)
     {
-      const auto &[p1, p2] = diagIter->second;
-      segmentDic[coord].push_back(std::make_shared<GridSegmentLinear>(
-          std::make_pair(xtl + p1.first, ytl + p1.second),
-          std::make_pair(xtl + p2.first, ytl + p2.second)));
-    }
-
-    auto circIter = TILE_SEGMENT_CIRCULAR_MAP.find(tileId);
-    if (circIter != TILE_SEGMENT_CIRCULAR_MAP.end())
-    {
-      const auto &[center, quadrant, convex] = circIter->second;
-      segmentDic[coord].push_back(std::make_shared<GridSegmentCircular>(
-          std::make_pair(xtl + center.first, ytl + center.second),
-          quadrant, convex));
-    }
-  }
-
-  // Initiate segments from the dictionaries of orthogonal linear segments.
-  // Note that two segments of the same position but opposite orientation cancel each other,
-  // and no segment is initiated.
-  for (const auto &[coord, state] : horSegmentDic)
-  {
-    if (state)
-    {
-      auto [xcoord, ycoord] = coord;
-      CellCoord cell{static_cast<int>(std::floor(xcoord / 2)),
-                     static_cast<int>(std::floor((ycoord - 0.1f * state) / 2))};
-
-      std::pair<float, float> point1{12 * xcoord, 12 * ycoord};
-      std::pair<float, float> point2{12 * xcoord + 12, 12 * ycoord};
-
-      if (state == -1)
+      for (auto &door : pool.entities)
       {
-        std::swap(point1, point2);
+        door.clearGridEdges();
       }
-
-      segmentDic[cell].push_back(std::make_shared<GridSegmentLinear>(point1, point2));
-    }
-  }
-
-  for (const auto &[coord, state] : verSegmentDic)
-  {
-    if (state)
+    } });
+  entityPools->forEach([](auto &pool)
+                       {
+    using T = typename std::decay_t<decltype(pool)>::Type;
+    if constexpr (std::is_base_of_v<DoorBase, T>)
     {
-      auto [xcoord, ycoord] = coord;
-      CellCoord cell{static_cast<int>(std::floor((xcoord - 0.1f * state) / 2)),
-                     static_cast<int>(std::floor(ycoord / 2))};
-
-      std::pair<float, float> point1{12 * xcoord, 12 * ycoord + 12};
-      std::pair<float, float> point2{12 * xcoord, 12 * ycoord};
-
-      if (state == -1)
+      for (auto &door : pool.entities)
       {
-        std::swap(point1, point2);
+        door.applyGridState();
       }
-
-      segmentDic[cell].push_back(std::make_shared<GridSegmentLinear>(point1, point2));
-    }
-  }
+    } });
 }
 
 void Simulation::loadMapEntities()
 {
+  const auto &mapData = map->getMapData();
   // Create player ninja
-  float xPos = mapData[1231] * 6;
-  float yPos = mapData[1232] * 6;
+  Real xPos = mapData[1231] * 6;
+  Real yPos = mapData[1232] * 6;
   ninja = std::make_unique<Ninja>(xPos, yPos);
 
   // Reset entity counts
-  std::fill(Entity::entityCounts.begin(), Entity::entityCounts.end(), 0);
+  entityCounts.fill(0);
+  reserveEntityPools();
 
   // Process entity data
   size_t index = 1235;
@@ -364,25 +177,25 @@ void Simulation::loadMapEntities()
       continue;
     }
 
-    float xpos = static_cast<float>(mapData[index + 1]);
-    float ypos = static_cast<float>(mapData[index + 2]);
+    Real xpos = static_cast<Real>(mapData[index + 1]);
+    Real ypos = static_cast<Real>(mapData[index + 2]);
     int orientation = mapData[index + 3];
     int mode = mapData[index + 4];
 
-    float switchX = -1;
-    float switchY = -1;
+    Real switchX = -1;
+    Real switchY = -1;
 
     // Handle switch coordinates for doors
     if (entityType == 6 || entityType == 8)
     {
-      switchX = static_cast<float>(mapData[index + 6]);
-      switchY = static_cast<float>(mapData[index + 7]);
+      switchX = static_cast<Real>(mapData[index + 6]);
+      switchY = static_cast<Real>(mapData[index + 7]);
     }
     // Handle exit door switch coordinates
     else if (entityType == 3)
     {
-      switchX = static_cast<float>(mapData[index + 5 * exitDoorCount + 1]);
-      switchY = static_cast<float>(mapData[index + 5 * exitDoorCount + 2]);
+      switchX = static_cast<Real>(mapData[index + 5 * exitDoorCount + 1]);
+      switchY = static_cast<Real>(mapData[index + 5 * exitDoorCount + 2]);
     }
 
     auto entity = createEntity(entityType, xpos, ypos, orientation, mode, switchX, switchY);
@@ -394,175 +207,232 @@ void Simulation::loadMapEntities()
 
     index += 5;
   }
+
+  // Pack door segments now that every door has registered its own
+  doorSegments.build();
 }
 
-std::shared_ptr<Entity> Simulation::createEntity(int entityType, float xpos, float ypos, int orientation, int mode, float switchX, float switchY)
+Entity *Simulation::createEntity(int entityType, Real xpos, Real ypos, int orientation, int mode, Real switchX, Real switchY)
 {
-  std::shared_ptr<Entity> entity;
+  auto &pools = entityPools->pools;
+  Entity *entity = nullptr;
 
   switch (entityType)
   {
   case 1: // Toggle Mine
-    entity = std::static_pointer_cast<Entity>(std::make_shared<ToggleMine>(this, xpos, ypos, 0));
+    entity = std::get<EntityPool<ToggleMine>>(pools).create(this, xpos, ypos, 0);
     break;
   case 2: // Gold
-    entity = std::static_pointer_cast<Entity>(std::make_shared<Gold>(this, xpos, ypos));
+    entity = std::get<EntityPool<Gold>>(pools).create(this, xpos, ypos);
     break;
   case 3:
   { // Exit Door
-    auto exitDoor = std::make_shared<ExitDoor>(this, xpos, ypos);
-    auto &typeList = entityDic[entityType];
-    typeList.push_back(std::static_pointer_cast<Entity>(exitDoor));
+    auto *exitDoor = std::get<EntityPool<ExitDoor>>(pools).create(this, xpos, ypos);
+    entityDic[entityType].push_back(exitDoor);
 
     // Create and return the exit switch using provided coordinates
-    entity = std::static_pointer_cast<Entity>(std::make_shared<ExitSwitch>(this, switchX, switchY, exitDoor.get()));
+    entity = std::get<EntityPool<ExitSwitch>>(pools).create(this, switchX, switchY, exitDoor);
     break;
   }
   case 5: // Regular Door
-    entity = std::static_pointer_cast<Entity>(std::make_shared<DoorRegular>(this, xpos, ypos, orientation, xpos, ypos));
+    entity = std::get<EntityPool<DoorRegular>>(pools).create(this, xpos, ypos, orientation, xpos, ypos);
     break;
   case 6: // Locked Door
-    entity = std::static_pointer_cast<Entity>(std::make_shared<DoorLocked>(this, xpos, ypos, orientation, switchX, switchY));
+    entity = std::get<EntityPool<DoorLocked>>(pools).create(this, xpos, ypos, orientation, switchX, switchY);
     break;
   case 8: // Trap Door
-    entity = std::static_pointer_cast<Entity>(std::make_shared<DoorTrap>(this, xpos, ypos, orientation, switchX, switchY));
+    entity = std::get<EntityPool<DoorTrap>>(pools).create(this, xpos, ypos, orientation, switchX, switchY);
     break;
   case 10: // Launch Pad
-    entity = std::static_pointer_cast<Entity>(std::make_shared<LaunchPad>(this, xpos, ypos, orientation));
+    entity = std::get<EntityPool<LaunchPad>>(pools).create(this, xpos, ypos, orientation);
     break;
   case 11: // One Way Platform
-    entity = std::static_pointer_cast<Entity>(std::make_shared<OneWayPlatform>(this, xpos, ypos, orientation));
+    entity = std::get<EntityPool<OneWayPlatform>>(pools).create(this, xpos, ypos, orientation);
     break;
   case 14: // Drone Zap
     if (!simConfig.basicSim)
     {
-      entity = std::static_pointer_cast<Entity>(std::make_shared<DroneZap>(this, xpos, ypos, orientation, mode));
+      entity = std::get<EntityPool<DroneZap>>(pools).create(this, xpos, ypos, orientation, mode);
     }
     break;
   case 15: // Drone Chaser - Commented out in Python
     // Intentionally not implemented to match Python
     break;
   case 17: // Bounce Block
-    entity = std::static_pointer_cast<Entity>(std::make_shared<BounceBlock>(this, xpos, ypos));
+    entity = std::get<EntityPool<BounceBlock>>(pools).create(this, xpos, ypos);
     break;
   case 20: // Thwump
-    entity = std::static_pointer_cast<Entity>(std::make_shared<Thwump>(this, xpos, ypos, orientation));
+    entity = std::get<EntityPool<Thwump>>(pools).create(this, xpos, ypos, orientation);
     break;
   case 21: // Toggle Mine (toggled state)
-    entity = std::static_pointer_cast<Entity>(std::make_shared<ToggleMine>(this, xpos, ypos, 1));
+    entity = std::get<EntityPool<ToggleMine>>(pools).create(this, xpos, ypos, 1);
     break;
   case 23: // Laser - Commented out in Python
     // Intentionally not implemented to match Python
     break;
   case 24: // Boost Pad
-    entity = std::static_pointer_cast<Entity>(std::make_shared<BoostPad>(this, xpos, ypos));
+    entity = std::get<EntityPool<BoostPad>>(pools).create(this, xpos, ypos);
     break;
   case 25: // Death Ball
     if (!simConfig.basicSim)
     {
-      entity = std::static_pointer_cast<Entity>(std::make_shared<DeathBall>(this, xpos, ypos));
+      entity = std::get<EntityPool<DeathBall>>(pools).create(this, xpos, ypos);
     }
     break;
   case 26: // Mini Drone
     if (!simConfig.basicSim)
     {
-      entity = std::static_pointer_cast<Entity>(std::make_shared<MiniDrone>(this, xpos, ypos, orientation, mode));
+      entity = std::get<EntityPool<MiniDrone>>(pools).create(this, xpos, ypos, orientation, mode);
     }
     break;
   case 28: // Shove Thwump
-    entity = std::static_pointer_cast<Entity>(std::make_shared<ShoveThwump>(this, xpos, ypos));
+    entity = std::get<EntityPool<ShoveThwump>>(pools).create(this, xpos, ypos);
     break;
   }
 
   return entity;
 }
 
-void Simulation::addEntity(std::shared_ptr<Entity> entity)
+void Simulation::reserveEntityPools()
+{
+  const auto &mapData = map->getMapData();
+  // Count every entity record first so no pool reallocates while entities are created
+  std::array<size_t, 256> typeCounts{};
+  for (size_t index = 1235; index < mapData.size(); index += 5)
+  {
+    typeCounts[mapData[index]]++;
+  }
+  typeCounts[ToggleMine::ENTITY_TYPE] += typeCounts[21];
+  typeCounts[ExitSwitch::ENTITY_TYPE] += typeCounts[ExitDoor::ENTITY_TYPE];
+
+  entityPools->forEach([&](auto &pool)
+                       {
+    using T = typename std::decay_t<decltype(pool)>::Type;
+    pool.entities.reserve(typeCounts[T::ENTITY_TYPE]); });
+}
+
+void Simulation::addEntity(Entity *entity)
 {
   if (!entity)
     return;
 
   int type = entity->getType();
-  auto cell = entity->getCell();
 
   entityDic[type].push_back(entity);
-  gridEntity[cell].push_back(entity);
+  addEntityToGrid(entity);
+
+  if (entity->isMovable() || entity->isThinkable())
+  {
+    updateActiveEntities(type);
+  }
 }
 
-void Simulation::removeEntity(std::shared_ptr<Entity> entity)
+void Simulation::addEntityToGrid(Entity *entity)
+{
+  auto &cellList = gridEntity[entity->getCell()];
+  entity->setGridSlot(cellList.size());
+  cellList.push_back(entity);
+  invalidateEntityNeighbourhood();
+}
+
+void Simulation::removeEntityFromGrid(Entity *entity)
+{
+  // Swap-remove: the entity remembers its slot, so no search is needed
+  auto &cellList = gridEntity[entity->getCell()];
+  size_t slot = entity->getGridSlot();
+  if (slot >= cellList.size() || cellList[slot] != entity)
+    return;
+
+  cellList[slot] = cellList.back();
+  cellList[slot]->setGridSlot(slot);
+  cellList.pop_back();
+  entity->setGridSlot(Entity::NOT_IN_GRID);
+  invalidateEntityNeighbourhood();
+}
+
+void Simulation::removeEntity(Entity *entity)
 {
   if (!entity)
     return;
 
   int type = entity->getType();
-  auto cell = entity->getCell();
 
   // Remove from type dictionary
   auto &typeList = entityDic[type];
   typeList.erase(std::remove(typeList.begin(), typeList.end(), entity), typeList.end());
 
-  // Remove from grid
-  auto &cellList = gridEntity[cell];
-  cellList.erase(std::remove(cellList.begin(), cellList.end(), entity), cellList.end());
+  removeEntityFromGrid(entity);
+
+  if (entity->isMovable() || entity->isThinkable())
+  {
+    updateActiveEntities(type);
+  }
 }
 
-void Simulation::tick(int horInput, int jumpInput)
+void Simulation::updateActiveEntities(int type)
 {
-  // Increment the current frame
-  frame++;
-
-  // Store inputs as ninja variables
-  ninja->setHorInput(horInput);
-  ninja->setJumpInput(jumpInput);
-
-  // Cache active entities to avoid repeated filtering
-  std::vector<std::shared_ptr<Entity>> activeMovableEntities;
-  std::vector<std::shared_ptr<Entity>> activeThinkableEntities;
-
-  // Single pass to categorize entities
-  for (const auto &[type, entityList] : entityDic)
-  {
-    for (const auto &entity : entityList)
+  // Rebuild the active list of this type's pool, keeping the entityDic order
+  entityPools->forEach([&](auto &pool)
+                       {
+    using T = typename std::decay_t<decltype(pool)>::Type;
+    if (T::ENTITY_TYPE != type)
+      return;
+
+    pool.active.clear();
+    for (auto *entity : entityDic[type])
     {
-      if (!entity->isActive())
-        continue;
-
-      if (entity->isMovable())
-      {
-        activeMovableEntities.push_back(entity);
-      }
-      if (entity->isThinkable())
+      if (entity->isActive())
       {
-        activeThinkableEntities.push_back(entity);
+        pool.active.push_back(static_cast<T *>(entity));
       }
     }
-  }
+  });
+}
 
-  // Move all movable entities
-  for (const auto &entity : activeMovableEntities)
+const Simulation::EntityList &Simulation::getEntityNeighbourhood(Real xpos, Real ypos)
+{
+  CellCoord cell = clampCell(std::floor(xpos / 24), std::floor(ypos / 24));
+  if (neighbourhoodValid && cell == neighbourhoodCell)
   {
-    entity->move();
+    neighbourhoodStats.hits++;
+    return neighbourhood;
   }
 
-  // Make all thinkable entities think
-  for (const auto &entity : activeThinkableEntities)
-  {
-    entity->think();
-  }
+  neighbourhoodStats.misses++;
+  Physics::gatherEntitiesFromNeighbourhood(*this, xpos, ypos, neighbourhood);
+  neighbourhoodCell = cell;
+  neighbourhoodValid = true;
+  return neighbourhood;
+}
+
+void Simulation::tick(int horInput, int jumpInput)
+{
+  // Increment the current frame
+  frame++;
+
+  // Store inputs as ninja variables
+  ninja->setHorInput(horInput);
+  ninja->setJumpInput(jumpInput);
+
+  // Move all movable entities, then make all thinkable entities think, one type at a time
+  entityPools->forEach([](auto &pool)
+                       { pool.moveAll(); });
+  entityPools->forEach([](auto &pool)
+                       { pool.thinkAll(); });
 
   if (ninja->getState() != 9)
   {
     ninja->integrate();    // Do preliminary speed and position updates
     ninja->preCollision(); // Do pre collision calculations
 
-    // Cache collision results
-    for (int i = 0; i < 4; i++)
+    // Handle physical collisions with entities, then tiles, up to four times.
+    // Stop early once a pass changes nothing, since the next ones would not either.
+    int passes = 1;
+    while (ninja->collisionPass(*this) && passes < COLLISION_PASSES)
     {
-      // Handle PHYSICAL collisions with entities
-      ninja->collideVsObjects(*this);
-      // Handle physical collisions with tiles
-      ninja->collideVsTiles(*this);
+      passes++;
     }
+    collisionPassHistogram[passes - 1]++;
 
     ninja->postCollision(*this); // Do post collision calculations
     ninja->think();              // Make ninja think
@@ -587,42 +457,32 @@ void Simulation::tick(int horInput, int jumpInput)
     ninja->log(frame);
 
     // Batch entity position logging
-    for (const auto &entity : activeMovableEntities)
-    {
-      entity->logPosition();
-    }
-  }
-
-  // Clear physics caches periodically
-  if (frame % 100 == 0)
-  {
-    Physics::clearCaches();
+    entityPools->forEach([](auto &pool)
+                         { pool.logPositions(); });
   }
 }
 
-Simulation::EntityList Simulation::getEntitiesInRadius(float x, float y, float radius) const
+Simulation::EntityList Simulation::getEntitiesInRadius(Real x, Real y, Real radius) const
 {
   EntityList result;
 
   // Calculate grid cell range to check
-  int minCellX = static_cast<int>((x - radius) / 6.0f);
-  int maxCellX = static_cast<int>((x + radius) / 6.0f);
-  int minCellY = static_cast<int>((y - radius) / 6.0f);
-  int maxCellY = static_cast<int>((y + radius) / 6.0f);
+  int minCellX = static_cast<int>((x - radius) / Real(6.0));
+  int maxCellX = static_cast<int>((x + radius) / Real(6.0));
+  int minCellY = static_cast<int>((y - radius) / Real(6.0));
+  int maxCellY = static_cast<int>((y + radius) / Real(6.0));
 
   // Gather entities from each cell in range
   for (int cellX = minCellX; cellX <= maxCellX; ++cellX)
   {
     for (int cellY = minCellY; cellY <= maxCellY; ++cellY)
     {
-      CellCoord cell{cellX, cellY};
-      auto it = gridEntity.find(cell);
-      if (it != gridEntity.end())
+      if (gridEntity.contains(cellX, cellY))
       {
-        for (const auto &entity : it->second)
+        for (const auto &entity : gridEntity[{cellX, cellY}])
         {
-          float dx = entity->getXPos() - x;
-          float dy = entity->getYPos() - y;
+          Real dx = entity->getXPos() - x;
+          Real dy = entity->getYPos() - y;
           if (dx * dx + dy * dy <= radius * radius)
           {
             result.push_back(entity);
@@ -632,32 +492,5 @@ Simulation::EntityList Simulation::getEntitiesInRadius(float x, float y, float r
     }
   }
 
-  return result;
-}
-
-Simulation::SegmentList Simulation::getSegmentsInRegion(float x1, float y1, float x2, float y2) const
-{
-  SegmentList result;
-
-  // Calculate grid cell range to check
-  int minCellX = static_cast<int>(std::min(x1, x2) / 6.0f);
-  int maxCellX = static_cast<int>(std::max(x1, x2) / 6.0f);
-  int minCellY = static_cast<int>(std::min(y1, y2) / 6.0f);
-  int maxCellY = static_cast<int>(std::max(y1, y2) / 6.0f);
-
-  // Gather segments from each cell in range
-  for (int cellX = minCellX; cellX <= maxCellX; ++cellX)
-  {
-    for (int cellY = minCellY; cellY <= maxCellY; ++cellY)
-    {
-      CellCoord cell{cellX, cellY};
-      auto it = segmentDic.find(cell);
-      if (it != segmentDic.end())
-      {
-        result.insert(result.end(), it->second.begin(), it->second.end());
-      }
-    }
-  }
-
   return result;
 }
\ No newline at end of file
@@ -1,8 +1,8 @@
 #pragma once
 
 #include "sim_config.hpp"
-#include "physics/grid_segment_linear.hpp"
-#include "physics/grid_segment_circular.hpp"
+#include "compiled_map.hpp"
+#include "physics/segment_store.hpp"
 #include "utils.hpp"
 
 #include <unordered_map>
@@ -12,6 +12,7 @@
 #include <cstdint>
 #include <tuple>
 #include <utility>
+#include <algorithm>
 #include <string>
 #include <fstream>
 #include <sstream>
@@ -20,6 +21,8 @@
 // Forward declarations
 class Entity;
 class Ninja;
+struct EntityPools;
+struct SimulationState;
 
 using CellCoord = std::pair<int, int>;
 
@@ -27,86 +30,188 @@ class Simulation
 {
 public:
   // Grid data structures
-  using SegmentList = std::vector<std::shared_ptr<Segment>>;
-  using EntityList = std::vector<std::shared_ptr<Entity>>;
+  using EntityList = std::vector<Entity *>; // Entities are owned by the per-type pools
+  using DoorEdgeGrid = Grid<int8_t, 89, 51>;
 
-  // Tile map constants
-  static const std::unordered_map<int, std::array<int, 12>> TILE_GRID_EDGE_MAP;
-  static const std::unordered_map<int, std::array<int, 12>> TILE_SEGMENT_ORTHO_MAP;
-  static const std::unordered_map<int, std::tuple<std::pair<int, int>, std::pair<int, int>>> TILE_SEGMENT_DIAG_MAP;
-  static const std::unordered_map<int, std::tuple<std::pair<int, int>, std::pair<int, int>, bool>> TILE_SEGMENT_CIRCULAR_MAP;
+  struct NeighbourhoodCacheStats
+  {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
+
+  // Ninja collision passes per tick, at most COLLISION_PASSES
+  static constexpr int COLLISION_PASSES = 4;
+  using CollisionPassHistogram = std::array<uint64_t, COLLISION_PASSES>; // Ticks that used 1, 2, 3 and 4 passes
 
   // Constructor
   explicit Simulation(const SimConfig &sc);
+  ~Simulation();
 
   // Map loading and reset methods
   void load(const std::vector<uint8_t> &mapData);
+  void load(std::shared_ptr<const CompiledMap> compiledMap);
   void reset();
 
   // Main simulation update
   void tick(int horInput, int jumpInput);
 
+  // Copy the dynamic state out of a simulation and into this or any other
+  // simulation on the same CompiledMap. restore() throws
+  // std::invalid_argument for a state taken on another map.
+  void snapshot(SimulationState &state) const;
+  void restore(const SimulationState &state);
+
   // Public accessors
   const Ninja *getNinja() const { return ninja.get(); }
   Ninja *getNinja() { return ninja.get(); }
   const SimConfig &getConfig() const { return simConfig; }
   int getFrame() const { return frame; }
+  int getEntityCount(int type) const { return entityCounts.at(type); }
+  void incrementEntityCount(int type)
+  {
+    if (type >= 0 && type < static_cast<int>(entityCounts.size()))
+    {
+      entityCounts[type]++;
+    }
+  }
 
   // Entity management
-  std::shared_ptr<Entity> createEntity(int entityType, float xpos, float ypos, int orientation, int mode, float switchX = -1, float switchY = -1);
-  void addEntity(std::shared_ptr<Entity> entity);
-  void removeEntity(std::shared_ptr<Entity> entity);
+  Entity *createEntity(int entityType, Real xpos, Real ypos, int orientation, int mode, Real switchX = -1, Real switchY = -1);
+  void addEntity(Entity *entity);
+  void removeEntity(Entity *entity);
+  void addEntityToGrid(Entity *entity);
+  void removeEntityFromGrid(Entity *entity);
+
+  // Refresh the active entity lists after an entity of this type was added,
+  // removed, activated or deactivated
+  void updateActiveEntities(int type);
+
+  // Active entities of the 3x3 cells around a position, as built by
+  // Physics::gatherEntitiesFromNeighbourhood. The list is kept until the
+  // position moves to another cell or an entity enters, leaves or changes
+  // its active flag anywhere in the grid, so the ninja's collision passes of
+  // a tick usually share one list. It stays valid until the next call.
+  const EntityList &getEntityNeighbourhood(Real xpos, Real ypos);
+  void invalidateEntityNeighbourhood() { neighbourhoodValid = false; }
+  const NeighbourhoodCacheStats &getNeighbourhoodCacheStats() const { return neighbourhoodStats; }
+
+  const CollisionPassHistogram &getCollisionPassHistogram() const { return collisionPassHistogram; }
 
   // Mutable accessors for entity management
-  SegmentList &getSegmentsAt(const CellCoord &cell) { return segmentDic[cell]; }
-  EntityList &getEntitiesAt(const CellCoord &cell) { return gridEntity[cell]; }
+  SegmentStore &getDoorSegments() { return doorSegments; }
   EntityList &getEntitiesByType(int type) { return entityDic[type]; }
   const EntityList &getEntitiesOfType(int type) const { return entityDic.at(type); }
 
   // Const accessors for entity management
-  const SegmentList &getSegmentsAt(const CellCoord &cell) const { return segmentDic.at(cell); }
-  const EntityList &getEntitiesAt(const CellCoord &cell) const { return gridEntity.at(cell); }
+  const SegmentStore &getDoorSegments() const { return doorSegments; }
+  const EntityList &getEntitiesAt(const CellCoord &cell) const { return gridEntity[cell]; }
   const EntityList &getEntitiesByType(int type) const { return entityDic.at(type); }
 
   // Grid edge accessors
-  bool hasHorizontalEdge(const CellCoord &cell) const { return horGridEdgeDic.at(cell) != 0; }
-  bool hasVerticalEdge(const CellCoord &cell) const { return verGridEdgeDic.at(cell) != 0; }
+  bool hasHorizontalEdge(const CellCoord &cell) const { return horEdgeBits.test(cell.second, cell.first); }
+  bool hasVerticalEdge(const CellCoord &cell) const { return verEdgeBits.test(cell.first, cell.second); }
+  // Combined tile and door edges, for testing spans of a row or column at once
+  const CompiledMap::HorEdgeBits &getHorEdgeBits() const { return horEdgeBits; }
+  const CompiledMap::VerEdgeBits &getVerEdgeBits() const { return verEdgeBits; }
 
   // Map data accessors
-  uint8_t getTileAt(int x, int y) const { return tileDic.at({x, y}); }
-
-  // Add these accessor methods
-  void incrementVerGridEdge(const std::pair<int, int> &edge, int amount) { verGridEdgeDic[edge] += amount; }
-  void incrementHorGridEdge(const std::pair<int, int> &edge, int amount) { horGridEdgeDic[edge] += amount; }
+  const std::shared_ptr<const CompiledMap> &getCompiledMap() const { return map; }
+  uint8_t getTileAt(int x, int y) const { return map->getTileDic().at(x, y); }
+
+  // Door edges are kept on top of the shared tile edges
+  void incrementVerGridEdge(const std::pair<int, int> &edge, int amount) { setVerGridEdge(edge, doorVerGridEdges[edge] + amount); }
+  void incrementHorGridEdge(const std::pair<int, int> &edge, int amount) { setHorGridEdge(edge, doorHorGridEdges[edge] + amount); }
+  void setVerGridEdge(const std::pair<int, int> &edge, int value)
+  {
+    doorVerGridEdges[edge] = value;
+    verEdgeBits.set(edge.first, edge.second, map->getVerGridEdge(edge) + doorVerGridEdges[edge] != 0);
+  }
+  void setHorGridEdge(const std::pair<int, int> &edge, int value)
+  {
+    doorHorGridEdges[edge] = value;
+    horEdgeBits.set(edge.second, edge.first, map->getHorGridEdge(edge) + doorHorGridEdges[edge] != 0);
+  }
 
   // Entity and segment gathering methods
-  EntityList getEntitiesInRadius(float x, float y, float radius) const;
-  SegmentList getSegmentsInRegion(float x1, float y1, float x2, float y2) const;
+  EntityList getEntitiesInRadius(Real x, Real y, Real radius) const;
+  // Whether a tile or door segment, active or not, lies in the cell
+  bool hasSegmentsAt(const CellCoord &cell) const { return map->getSegments().hasSegments(cell) || doorSegments.hasSegments(cell); }
+  template <typename Visitor>
+  void forEachSegmentInCell(const CellCoord &cell, Visitor &&visitor) const;
+  template <typename Visitor>
+  void forEachSegmentInRegion(Real x1, Real y1, Real x2, Real y2, Visitor &&visitor) const;
 
   // Add tile dictionary accessor
-  const TileDictionary &getTileDic() const { return tileDic; }
+  const TileDictionary &getTileDic() const { return map->getTileDic(); }
 
 private:
   // Internal map loading methods
   void resetMapEntityData();
-  void resetMapTileData();
-  void loadMapTiles();
   void loadMapEntities();
+  void reserveEntityPools();
 
   // State variables
   int frame;
-  std::vector<std::tuple<int, float, float>> collisionLog;
+  std::vector<std::tuple<int, Real, Real>> collisionLog;
   SimConfig const &simConfig;
   std::unique_ptr<Ninja> ninja;
-
-  // Map data structures
-  std::unordered_map<CellCoord, int, CellCoordHash> tileDic;
-  std::unordered_map<CellCoord, SegmentList, CellCoordHash> segmentDic;
-  std::unordered_map<CellCoord, EntityList, CellCoordHash> gridEntity;
-  std::unordered_map<int, EntityList> entityDic;
-  std::unordered_map<CellCoord, int, CellCoordHash> horGridEdgeDic;
-  std::unordered_map<CellCoord, int, CellCoordHash> verGridEdgeDic;
-  std::unordered_map<CellCoord, int, CellCoordHash> horSegmentDic;
-  std::unordered_map<CellCoord, int, CellCoordHash> verSegmentDic;
-  std::vector<uint8_t> mapData;
-};
\ No newline at end of file
+  std::array<int, 40> entityCounts{};
+
+  // Map data structures. Cell maps are 44x25 and half-cell maps are 89x51.
+  // The static geometry is shared with every simulation on the same level.
+  std::shared_ptr<const CompiledMap> map;
+  SegmentStore doorSegments;
+  DoorEdgeGrid doorHorGridEdges;
+  DoorEdgeGrid doorVerGridEdges;
+  CompiledMap::HorEdgeBits horEdgeBits; // Whether tile plus door edges are nonzero
+  CompiledMap::VerEdgeBits verEdgeBits;
+  Grid<EntityList, 44, 25> gridEntity;
+  std::array<EntityList, 29> entityDic;
+
+  EntityList neighbourhood;
+  CellCoord neighbourhoodCell;
+  bool neighbourhoodValid = false;
+  NeighbourhoodCacheStats neighbourhoodStats;
+
+  CollisionPassHistogram collisionPassHistogram{};
+
+  // Entity storage, one contiguous pool per type. Each pool also keeps its
+  // active entities, maintained incrementally instead of rebuilt every tick.
+  std::unique_ptr<EntityPools> entityPools;
+
+  // State right after the map entities were loaded. reset() restores it
+  // instead of parsing the map again.
+  std::unique_ptr<SimulationState> initialState;
+};
+
+template <typename Visitor>
+void Simulation::forEachSegmentInCell(const CellCoord &cell, Visitor &&visitor) const
+{
+  // Door segments are linear and were staged after the tile segments of their cell
+  const SegmentStore &tileSegments = map->getSegments();
+  tileSegments.forEachLinearInCell(cell, visitor);
+  doorSegments.forEachLinearInCell(cell, visitor);
+  tileSegments.forEachCircularInCell(cell, visitor);
+}
+
+template <typename Visitor>
+void Simulation::forEachSegmentInRegion(Real x1, Real y1, Real x2, Real y2, Visitor &&visitor) const
+{
+  // Calculate grid cell range to check
+  int minCellX = static_cast<int>(std::min(x1, x2) / Real(6.0));
+  int maxCellX = static_cast<int>(std::max(x1, x2) / Real(6.0));
+  int minCellY = static_cast<int>(std::min(y1, y2) / Real(6.0));
+  int maxCellY = static_cast<int>(std::max(y1, y2) / Real(6.0));
+
+  // Visit segments from each cell in range
+  for (int cellX = minCellX; cellX <= maxCellX; ++cellX)
+  {
+    for (int cellY = minCellY; cellY <= maxCellY; ++cellY)
+    {
+      if (cellX >= 0 && cellX < SegmentStore::WIDTH && cellY >= 0 && cellY < SegmentStore::HEIGHT)
+      {
+        forEachSegmentInCell({cellX, cellY}, visitor);
+      }
+    }
+  }
+}
\ No newline at end of file
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "simulation.hpp"
+#include "ninja.hpp"
+#include "entities/entity_pool.hpp"
+
+#include <memory>
+#include <vector>
+#include <tuple>
+#include <optional>
+#include <cstdint>
+
+// Dynamic state of a Simulation, filled by Simulation::snapshot and put back
+// by Simulation::restore. Static geometry is not included, since it is shared
+// through the CompiledMap, and neither are door segments and grid edges, which
+// follow from the restored door states.
+//
+// A state can be restored into any simulation that loaded the same
+// CompiledMap, such as another worker of a VecSimulation or a simulation that
+// loaded the same level data, since those hold the same entities in the same
+// pool slots. The state keeps the map alive, so CompiledMap::getShared keeps
+// returning it for that level. Reusing one state object for repeated
+// snapshots does not allocate once its buffers have grown.
+struct SimulationState
+{
+  std::shared_ptr<const CompiledMap> map;
+
+  int frame = 0;
+  std::vector<std::tuple<int, Real, Real>> collisionLog;
+  std::optional<Ninja> ninja;
+  EntityPools entityPools; // Door segments and grid edges are derived from the doors
+};
\ No newline at end of file
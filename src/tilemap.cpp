@@ -23,10 +23,9 @@ void TileMap::initialize(const TileDictionary &tileDic)
   {
     for (int x = 0; x < GRID_WIDTH; ++x)
     {
-      auto it = tileDic.find({x, y});
-      if (it != tileDic.end())
+      if (tileDic.contains(x, y))
       {
-        setTileVertices(x, y, it->second);
+        setTileVertices(x, y, tileDic[{x, y}]);
       }
     }
   }
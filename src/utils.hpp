@@ -1,39 +1,142 @@
 #pragma once
 
+#include "real.hpp"
+
 #include <utility>
 #include <cmath>
-#include <unordered_map>
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <cstdint>
 
-// Hash function for coordinate pairs
-struct CellCoordHash
+// Fixed-size grid of cells stored as a flat row-major array.
+// operator[] is unchecked and meant for the hot path, where callers already clamp
+// their coordinates; at() keeps the bounds-checked behaviour of the old hash maps.
+template <typename T, int Width, int Height>
+class Grid
 {
-  std::size_t operator()(const std::pair<int, int> &coord) const
+public:
+  static constexpr int WIDTH = Width;
+  static constexpr int HEIGHT = Height;
+
+  T &operator[](const std::pair<int, int> &cell) { return cells[index(cell.first, cell.second)]; }
+  const T &operator[](const std::pair<int, int> &cell) const { return cells[index(cell.first, cell.second)]; }
+
+  T &at(int x, int y)
+  {
+    checkBounds(x, y);
+    return cells[index(x, y)];
+  }
+  const T &at(int x, int y) const
   {
-    return std::hash<int>()(coord.first) ^ (std::hash<int>()(coord.second) << 1);
+    checkBounds(x, y);
+    return cells[index(x, y)];
   }
+
+  static constexpr bool contains(int x, int y) { return x >= 0 && x < Width && y >= 0 && y < Height; }
+
+  void fill(const T &value) { cells.fill(value); }
+
+  // Row-major iteration over every cell
+  auto begin() { return cells.begin(); }
+  auto end() { return cells.end(); }
+  auto begin() const { return cells.begin(); }
+  auto end() const { return cells.end(); }
+
+private:
+  static constexpr int index(int x, int y) { return y * Width + x; }
+
+  static void checkBounds(int x, int y)
+  {
+    if (!contains(x, y))
+    {
+      throw std::out_of_range("Grid cell out of range");
+    }
+  }
+
+  std::array<T, Width * Height> cells{};
 };
 
-// Type alias for tile dictionary
-using TileDictionary = std::unordered_map<std::pair<int, int>, int, CellCoordHash>;
+// Type alias for tile dictionary (44x25 cells including the outer border)
+using TileDictionary = Grid<int, 44, 25>;
+
+// One bit per cell of a grid, packed along lines of Length cells so that any
+// span of a line can be tested with a few word operations.
+template <int Lines, int Length>
+class Bitboard
+{
+public:
+  static constexpr int WORDS = (Length + 63) / 64;
+
+  bool test(int line, int pos) const { return bits[line][pos / 64] >> (pos % 64) & 1; }
+
+  void set(int line, int pos, bool value)
+  {
+    uint64_t bit = uint64_t(1) << (pos % 64);
+    bits[line][pos / 64] = value ? bits[line][pos / 64] | bit : bits[line][pos / 64] & ~bit;
+  }
+
+  // Whether any bit from first to last (inclusive) is set on the line
+  bool anyInSpan(int line, int first, int last) const
+  {
+    for (int word = first / 64; word <= last / 64; ++word)
+    {
+      uint64_t mask = ~uint64_t(0);
+      if (word == first / 64)
+      {
+        mask &= ~uint64_t(0) << (first % 64);
+      }
+      if (word == last / 64)
+      {
+        mask &= ~uint64_t(0) >> (63 - last % 64);
+      }
+      if (bits[line][word] & mask)
+      {
+        return true;
+      }
+    }
+    return false;
+  }
+
+private:
+  std::array<std::array<uint64_t, WORDS>, Lines> bits{};
+};
+
+// Working buffer owned by an object but not part of its state. Copies start
+// empty and assignment keeps the destination's own buffer, so snapshots of the
+// owner neither carry nor pay for the scratch contents.
+template <typename T>
+class Scratch
+{
+public:
+  Scratch() = default;
+  Scratch(const Scratch &) {}
+  Scratch &operator=(const Scratch &) { return *this; }
+
+  T &get() { return value; }
+
+private:
+  T value;
+};
 
 // Convert orientation (0-7) to a normalized vector
-inline std::pair<float, float> mapOrientationToVector(int orientation)
+inline std::pair<Real, Real> mapOrientationToVector(int orientation)
 {
   switch (orientation)
   {
   case 0:
   case 1:
-    return {1.0f, 0.0f};
+    return {Real(1.0), Real(0.0)};
   case 2:
   case 3:
-    return {0.0f, 1.0f};
+    return {Real(0.0), Real(1.0)};
   case 4:
   case 5:
-    return {-1.0f, 0.0f};
+    return {Real(-1.0), Real(0.0)};
   case 6:
   case 7:
   default:
-    return {0.0f, -1.0f};
+    return {Real(0.0), Real(-1.0)};
   }
 }
 
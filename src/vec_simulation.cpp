@@ -0,0 +1,224 @@
+#include "vec_simulation.hpp"
+#include "observation.hpp"
+#include "ninja.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+VecSimulation::VecSimulation(int count, const SimConfig &config, bool onlyExitAndSwitch, const Rewards &rewards)
+    : simConfig(config),
+      onlyExitAndSwitch(onlyExitAndSwitch),
+      observationSize(Observation::maxSize(onlyExitAndSwitch)),
+      rewards(rewards),
+      pool(std::make_unique<WorkStealingPool>(1))
+{
+  if (count < 1)
+  {
+    throw std::invalid_argument("VecSimulation needs at least one simulation");
+  }
+
+  sims.reserve(count);
+  for (int i = 0; i < count; ++i)
+  {
+    sims.push_back(std::make_unique<Simulation>(simConfig));
+  }
+}
+
+VecSimulation::VecSimulation(int count, const SimConfig &config, bool onlyExitAndSwitch)
+    : VecSimulation(count, config, onlyExitAndSwitch, Rewards())
+{
+}
+
+VecSimulation::~VecSimulation()
+{
+  if (asyncThread.joinable())
+  {
+    {
+      std::lock_guard<std::mutex> lock(asyncMutex);
+      asyncStopping = true;
+    }
+    asyncCondition.notify_all();
+    asyncThread.join();
+  }
+}
+
+void VecSimulation::loadMap(int index, const std::vector<uint8_t> &mapData)
+{
+  checkNoPendingStep();
+  sims.at(index)->load(mapData);
+}
+
+void VecSimulation::loadMap(const std::vector<uint8_t> &mapData)
+{
+  checkNoPendingStep();
+  auto map = CompiledMap::getShared(mapData);
+  for (auto &sim : sims)
+  {
+    sim->load(map);
+  }
+}
+
+void VecSimulation::reset(int index)
+{
+  checkNoPendingStep();
+  sims.at(index)->reset();
+}
+
+void VecSimulation::reset()
+{
+  checkNoPendingStep();
+  for (auto &sim : sims)
+  {
+    sim->reset();
+  }
+}
+
+void VecSimulation::writeObservations(float *observations) const
+{
+  checkNoPendingStep();
+  pool->run(size(), chunkSize, [&](int i)
+            { writeObservation(*sims[i], observations + i * observationSize); });
+}
+
+void VecSimulation::step(const int32_t *actions, float *observations, float *rewardsOut, uint8_t *dones)
+{
+  checkNoPendingStep();
+  runStep(actions, observations, rewardsOut, dones);
+}
+
+void VecSimulation::stepAsync(const int32_t *actions)
+{
+  checkNoPendingStep();
+  if (!asyncThread.joinable())
+  {
+    asyncActions.resize(2 * size());
+    for (auto &buffers : asyncBuffers)
+    {
+      buffers.observations.resize(static_cast<size_t>(size()) * observationSize);
+      buffers.rewards.resize(size());
+      buffers.dones.resize(size());
+    }
+    asyncThread = std::thread(&VecSimulation::asyncMain, this);
+  }
+
+  // Fill the buffer the caller is not reading
+  std::copy(actions, actions + asyncActions.size(), asyncActions.begin());
+  asyncBuffer ^= 1;
+  {
+    std::lock_guard<std::mutex> lock(asyncMutex);
+    asyncState = AsyncState::Requested;
+  }
+  asyncCondition.notify_all();
+}
+
+VecSimulation::StepResult VecSimulation::stepWait()
+{
+  std::unique_lock<std::mutex> lock(asyncMutex);
+  if (asyncState == AsyncState::Idle)
+  {
+    throw std::logic_error("VecSimulation::stepWait called without a pending stepAsync");
+  }
+  asyncCondition.wait(lock, [this]
+                      { return asyncState == AsyncState::Done; });
+  asyncState = AsyncState::Idle;
+  if (asyncError)
+  {
+    std::rethrow_exception(std::exchange(asyncError, nullptr));
+  }
+
+  const StepBuffers &buffers = asyncBuffers[asyncBuffer];
+  return {buffers.observations.data(), buffers.rewards.data(), buffers.dones.data()};
+}
+
+void VecSimulation::checkNoPendingStep() const
+{
+  if (isStepPending())
+  {
+    throw std::logic_error("VecSimulation used while an asynchronous step is pending");
+  }
+}
+
+void VecSimulation::runStep(const int32_t *actions, float *observations, float *rewardsOut, uint8_t *dones)
+{
+  pool->run(size(), chunkSize, [&](int i)
+            { stepOne(i, actions + 2 * i, observations + i * observationSize, rewardsOut + i, dones + i); });
+}
+
+void VecSimulation::setThreads(int threadCount, bool pinThreads, int chunkSize)
+{
+  checkNoPendingStep();
+  pool = std::make_unique<WorkStealingPool>(threadCount, pinThreads);
+  this->chunkSize = chunkSize;
+}
+
+void VecSimulation::asyncMain()
+{
+  std::unique_lock<std::mutex> lock(asyncMutex);
+  while (true)
+  {
+    asyncCondition.wait(lock, [this]
+                        { return asyncStopping || asyncState == AsyncState::Requested; });
+    if (asyncStopping)
+    {
+      return;
+    }
+
+    lock.unlock();
+    StepBuffers &buffers = asyncBuffers[asyncBuffer];
+    std::exception_ptr error;
+    try
+    {
+      runStep(asyncActions.data(), buffers.observations.data(), buffers.rewards.data(), buffers.dones.data());
+    }
+    catch (...)
+    {
+      error = std::current_exception();
+    }
+    lock.lock();
+
+    asyncError = error;
+    asyncState = AsyncState::Done;
+    asyncCondition.notify_all();
+  }
+}
+
+void VecSimulation::stepOne(int index, const int32_t *action, float *observation, float *reward, uint8_t *done)
+{
+  Simulation &sim = *sims[index];
+  Ninja *ninja = sim.getNinja();
+  if (!ninja)
+  {
+    throw std::logic_error("VecSimulation stepped before every simulation has a level");
+  }
+
+  int goldBefore = ninja->goldCollected;
+  sim.tick(action[0], action[1]);
+
+  *reward = (ninja->goldCollected - goldBefore) * rewards.gold;
+  *done = false;
+  if (ninja->hasWon())
+  {
+    *reward += rewards.win;
+    *done = true;
+  }
+  else if (ninja->hasDied())
+  {
+    *reward += rewards.death;
+    *done = true;
+  }
+  if (*done)
+  {
+    sim.reset();
+  }
+
+  writeObservation(sim, observation);
+}
+
+void VecSimulation::writeObservation(const Simulation &sim, float *row) const
+{
+  Observation::writeNinjaState(sim, row);
+  float *entityStates = row + Observation::NINJA_STATE_SIZE;
+  int written = Observation::writeEntityStates(sim, onlyExitAndSwitch, entityStates);
+  std::fill(entityStates + written, row + observationSize, 0.0f);
+}
\ No newline at end of file
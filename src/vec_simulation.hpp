@@ -0,0 +1,133 @@
+#pragma once
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "work_stealing_pool.hpp"
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A batch of independent simulations stepped together, so that a trainer
+// drives all its environments with one call per frame instead of one tick
+// and several getters per environment. step() writes the observations,
+// rewards and done flags of the whole batch into caller-provided row-major
+// arrays, one row per simulation. The simulations are stepped on a
+// WorkStealingPool, serially on the calling thread unless setThreads asks for
+// more.
+//
+// stepAsync and stepWait split a step in two so that the caller can run
+// policy inference while a background thread ticks the simulations. Their
+// results alternate between two internal buffers, so the results of one step
+// can be read while the next one is being simulated.
+class VecSimulation
+{
+public:
+  // Results of an asynchronous step, in the layout step() writes
+  struct StepResult
+  {
+    const float *observations;
+    const float *rewards;
+    const uint8_t *dones;
+  };
+
+  // Reward of a step: the terminal rewards, plus a bonus per gold collected
+  struct Rewards
+  {
+    float win = 1.0f;
+    float death = -1.0f;
+    float gold = 0.0f;
+  };
+
+  // Observations are Observation rows. With onlyExitAndSwitch, levels without
+  // an exit door or switch get zeros in place of the missing flags so that
+  // every row has the same size. The simulations share a copy of config.
+  VecSimulation(int count, const SimConfig &config, bool onlyExitAndSwitch, const Rewards &rewards);
+  VecSimulation(int count, const SimConfig &config, bool onlyExitAndSwitch = false);
+  ~VecSimulation();
+
+  int size() const { return sims.size(); }
+  int getObservationSize() const { return observationSize; }
+  // Throws std::logic_error while an asynchronous step is pending
+  Simulation &getSimulation(int index)
+  {
+    checkNoPendingStep();
+    return *sims.at(index);
+  }
+
+  // Load a level into one simulation, or into all of them with one shared CompiledMap.
+  // Every simulation needs a level before the first step.
+  void loadMap(int index, const std::vector<uint8_t> &mapData);
+  void loadMap(const std::vector<uint8_t> &mapData);
+  void reset(int index);
+  void reset();
+
+  // observations: size() rows of getObservationSize() values
+  void writeObservations(float *observations) const;
+
+  // actions: size() rows of (horizontal input, jump input). Simulations that
+  // won or died during the tick are reset afterwards, and their observation
+  // row is the first one of the new episode.
+  void step(const int32_t *actions, float *observations, float *rewards, uint8_t *dones);
+
+  // Start a step with a copy of actions on a background thread and return at
+  // once. stepWait blocks until it finished, rethrows its exception if any,
+  // and returns its results, which stay valid until the next stepWait. While
+  // a step is pending, the other methods changing the simulations throw.
+  void stepAsync(const int32_t *actions);
+  StepResult stepWait();
+  bool isStepPending() const { return asyncState != AsyncState::Idle; }
+
+  // Step and write observations on threadCount threads, 0 meaning one per CPU.
+  // The simulations do not share mutable state, so the results do not depend
+  // on the thread count. chunkSize is passed on to WorkStealingPool::run.
+  void setThreads(int threadCount, bool pinThreads = false, int chunkSize = 0);
+  const WorkStealingPool &getThreadPool() const { return *pool; }
+  WorkStealingPool &getThreadPool() { return *pool; }
+
+private:
+  enum class AsyncState
+  {
+    Idle,
+    Requested,
+    Done
+  };
+
+  struct StepBuffers
+  {
+    std::vector<float> observations;
+    std::vector<float> rewards;
+    std::vector<uint8_t> dones;
+  };
+
+  void checkNoPendingStep() const;
+  void runStep(const int32_t *actions, float *observations, float *rewards, uint8_t *dones);
+  void asyncMain();
+  void stepOne(int index, const int32_t *action, float *observation, float *reward, uint8_t *done);
+  void writeObservation(const Simulation &sim, float *row) const;
+
+  SimConfig simConfig; // Referenced by the simulations, so declared before them
+  std::vector<std::unique_ptr<Simulation>> sims;
+  bool onlyExitAndSwitch;
+  int observationSize;
+  Rewards rewards;
+  std::unique_ptr<WorkStealingPool> pool;
+  int chunkSize = 0;
+
+  // Asynchronous steps, run by asyncThread once the first one is requested
+  std::vector<int32_t> asyncActions;
+  std::array<StepBuffers, 2> asyncBuffers;
+  int asyncBuffer = 0;
+  std::atomic<AsyncState> asyncState{AsyncState::Idle}; // Written under asyncMutex
+  bool asyncStopping = false;
+  std::exception_ptr asyncError;
+  std::thread asyncThread;
+  std::mutex asyncMutex;
+  std::condition_variable asyncCondition;
+};
\ No newline at end of file
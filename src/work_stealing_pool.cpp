@@ -0,0 +1,258 @@
+#include "work_stealing_pool.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace
+{
+  uint64_t elapsedNs(std::chrono::steady_clock::time_point start)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  }
+}
+
+WorkStealingPool::WorkStealingPool(int threadCount, bool pinThreads)
+    : threadCount(threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency()))
+{
+  workers = std::make_unique<Worker[]>(this->threadCount);
+
+#ifdef __linux__
+  // Pin to the CPUs this process may run on, which taskset or a cpuset
+  // cgroup can restrict to any subset
+  std::vector<int> allowedCpus;
+  cpu_set_t processCpus;
+  if (pinThreads && sched_getaffinity(0, sizeof(processCpus), &processCpus) == 0)
+  {
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &processCpus))
+      {
+        allowedCpus.push_back(cpu);
+      }
+    }
+  }
+#else
+  (void)pinThreads;
+#endif
+
+  for (int i = 1; i < this->threadCount; ++i)
+  {
+    workers[i].thread = std::thread(&WorkStealingPool::workerMain, this, i);
+#ifdef __linux__
+    // A worker that cannot be pinned keeps the process's affinity
+    if (!allowedCpus.empty())
+    {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(allowedCpus[i % allowedCpus.size()], &cpus);
+      if (pthread_setaffinity_np(workers[i].thread.native_handle(), sizeof(cpus), &cpus) == 0)
+      {
+        ++pinnedCount;
+      }
+    }
+#endif
+  }
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  for (int i = 1; i < threadCount; ++i)
+  {
+    workers[i].thread.join();
+  }
+}
+
+void WorkStealingPool::run(int count, int chunkSizeIn, const std::function<void(int)> &taskIn)
+{
+  if (count <= 0)
+  {
+    return;
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  chunkSize = chunkSizeIn > 0 ? chunkSizeIn : std::max(1, count / (threadCount * 4));
+  uint32_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+  // Deal the chunks out in contiguous ranges, one per worker
+  for (int i = 0; i < threadCount; ++i)
+  {
+    uint32_t begin = static_cast<uint64_t>(chunkCount) * i / threadCount;
+    uint32_t end = static_cast<uint64_t>(chunkCount) * (i + 1) / threadCount;
+    workers[i].range.store(packRange(begin, end), std::memory_order_relaxed);
+  }
+
+  task = &taskIn;
+  taskCount = count;
+  error = nullptr;
+  if (threadCount > 1)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      busyWorkers = threadCount - 1;
+      generation++;
+    }
+    wake.notify_all();
+  }
+
+  workLoop(0);
+
+  if (threadCount > 1)
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    finished.wait(lock, [this]
+                  { return busyWorkers == 0; });
+  }
+  task = nullptr;
+  wallNs += elapsedNs(start);
+
+  if (error)
+  {
+    std::rethrow_exception(std::exchange(error, nullptr));
+  }
+}
+
+std::vector<WorkStealingPool::WorkerStats> WorkStealingPool::getWorkerStats() const
+{
+  std::vector<WorkerStats> stats;
+  stats.reserve(threadCount);
+  for (int i = 0; i < threadCount; ++i)
+  {
+    stats.push_back(workers[i].stats);
+  }
+  return stats;
+}
+
+void WorkStealingPool::resetStats()
+{
+  for (int i = 0; i < threadCount; ++i)
+  {
+    workers[i].stats = WorkerStats();
+  }
+  wallNs = 0;
+}
+
+void WorkStealingPool::workerMain(int index)
+{
+  uint64_t seen = 0;
+  while (true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [&]
+                { return stopping || generation != seen; });
+      if (stopping)
+      {
+        return;
+      }
+      seen = generation;
+    }
+
+    workLoop(index);
+
+    bool last;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      last = --busyWorkers == 0;
+    }
+    if (last)
+    {
+      finished.notify_one();
+    }
+  }
+}
+
+void WorkStealingPool::workLoop(int index)
+{
+  Worker &worker = workers[index];
+  uint32_t chunk;
+  while (popOwn(worker, chunk) || steal(index, chunk))
+  {
+    runChunk(worker, chunk);
+  }
+}
+
+bool WorkStealingPool::popOwn(Worker &worker, uint32_t &chunk)
+{
+  uint64_t range = worker.range.load(std::memory_order_acquire);
+  while (true)
+  {
+    uint32_t begin = range >> 32;
+    uint32_t end = static_cast<uint32_t>(range);
+    if (begin >= end)
+    {
+      return false;
+    }
+    if (worker.range.compare_exchange_weak(range, packRange(begin + 1, end), std::memory_order_acq_rel))
+    {
+      chunk = begin;
+      return true;
+    }
+  }
+}
+
+bool WorkStealingPool::steal(int index, uint32_t &chunk)
+{
+  Worker &thief = workers[index];
+  for (int offset = 1; offset < threadCount; ++offset)
+  {
+    Worker &victim = workers[(index + offset) % threadCount];
+    uint64_t range = victim.range.load(std::memory_order_acquire);
+    while (true)
+    {
+      uint32_t begin = range >> 32;
+      uint32_t end = static_cast<uint32_t>(range);
+      if (begin >= end)
+      {
+        break;
+      }
+
+      // Take the back half, leaving the victim the chunks it would run next
+      uint32_t middle = begin + (end - begin) / 2;
+      if (victim.range.compare_exchange_weak(range, packRange(begin, middle), std::memory_order_acq_rel))
+      {
+        // Nobody else writes to an empty range, so the thief can set its own
+        thief.range.store(packRange(middle + 1, end), std::memory_order_release);
+        thief.stats.steals++;
+        chunk = middle;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void WorkStealingPool::runChunk(Worker &worker, uint32_t chunk)
+{
+  auto start = std::chrono::steady_clock::now();
+  int begin = chunk * chunkSize;
+  int end = std::min(taskCount, begin + chunkSize);
+  for (int i = begin; i < end; ++i)
+  {
+    try
+    {
+      (*task)(i);
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+    }
+  }
+  worker.stats.tasks += end - begin;
+  worker.stats.busyNs += elapsedNs(start);
+}
\ No newline at end of file
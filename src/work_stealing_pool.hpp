@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Persistent worker threads for batches of independent tasks, such as
+// ticking every simulation of a VecSimulation. A batch is split in chunks of
+// consecutive tasks and each worker is dealt a contiguous range of chunks. A
+// worker runs its own range from the front and, once that is empty, steals
+// the back half of another worker's range, so uneven task costs (a drone
+// heavy level next to an empty one) even out without a shared queue.
+//
+// The calling thread takes part in every batch as worker 0, so a pool of one
+// thread runs batches serially without any synchronization.
+class WorkStealingPool
+{
+public:
+  struct WorkerStats
+  {
+    uint64_t busyNs = 0; // Time spent running tasks
+    uint64_t tasks = 0;
+    uint64_t steals = 0; // Ranges taken from other workers
+  };
+
+  // threadCount includes the calling thread, and 0 uses one thread per CPU.
+  // With pinThreads, background worker i is bound to the i-th CPU, modulo
+  // their count, of the CPUs the process is allowed to run on (Linux only).
+  // Workers that cannot be pinned run unpinned. The calling thread is left
+  // where it is.
+  explicit WorkStealingPool(int threadCount, bool pinThreads = false);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool &) = delete;
+  WorkStealingPool &operator=(const WorkStealingPool &) = delete;
+
+  int getThreadCount() const { return threadCount; }
+  // Background workers bound to a CPU, at most getThreadCount() - 1
+  int getPinnedCount() const { return pinnedCount; }
+
+  // Run task(i) for every i in [0, count) and return once all of them ran.
+  // A chunkSize of 0 gives each worker a few chunks. The first exception a
+  // task throws is rethrown here after the rest of the batch has run.
+  void run(int count, int chunkSize, const std::function<void(int)> &task);
+
+  // Statistics since construction or the last resetStats, read between
+  // batches. A worker's utilization is its busy time over the wall time.
+  std::vector<WorkerStats> getWorkerStats() const;
+  uint64_t getWallNs() const { return wallNs; }
+  void resetStats();
+
+private:
+  struct alignas(64) Worker
+  {
+    std::atomic<uint64_t> range{0}; // First chunk in the high half, end chunk in the low half
+    WorkerStats stats;
+    std::thread thread;
+  };
+
+  static uint64_t packRange(uint32_t begin, uint32_t end) { return static_cast<uint64_t>(begin) << 32 | end; }
+
+  void workerMain(int index);
+  void workLoop(int index);
+  bool popOwn(Worker &worker, uint32_t &chunk);
+  bool steal(int index, uint32_t &chunk);
+  void runChunk(Worker &worker, uint32_t chunk);
+
+  int threadCount;
+  int pinnedCount = 0;
+  std::unique_ptr<Worker[]> workers;
+
+  // Current batch, published to the background workers under the mutex
+  const std::function<void(int)> *task = nullptr;
+  int taskCount = 0;
+  int chunkSize = 1;
+  uint64_t generation = 0;
+  int busyWorkers = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::condition_variable finished;
+
+  uint64_t wallNs = 0;
+};
\ No newline at end of file
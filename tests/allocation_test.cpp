@@ -0,0 +1,105 @@
+// Checks that Simulation::tick does not allocate: global operator new is
+// replaced by a counting version, and every tick of a replayed episode on
+// levels crowded with entities must leave the count unchanged.
+//
+// Entity grid cells keep the capacity they grow to, so the first visit of an
+// entity to a cell can still allocate. Each level is therefore played once to
+// warm up, then reset and replayed with the same inputs while counting; the
+// replay visits the same cells, so any allocation it makes comes from the
+// tick itself.
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "test_levels.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+  std::atomic<bool> counting{false};
+  std::atomic<long> allocations{0};
+
+  void *allocate(std::size_t size)
+  {
+    if (counting.load(std::memory_order_relaxed))
+    {
+      allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void *memory = std::malloc(size ? size : 1))
+    {
+      return memory;
+    }
+    throw std::bad_alloc();
+  }
+}
+
+void *operator new(std::size_t size) { return allocate(size); }
+void *operator new[](std::size_t size) { return allocate(size); }
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete[](void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { std::free(memory); }
+
+namespace
+{
+  constexpr int LEVELS = 16;
+  constexpr int TICKS = 3000;
+
+  // Play the inputs, restarting the level whenever the ninja dies or wins.
+  // Returns the number of ticks (including their restarts) that allocated.
+  int play(Simulation &sim, const std::vector<std::pair<int, int>> &inputs, unsigned seed)
+  {
+    int failures = 0;
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+      long before = allocations.load();
+      sim.tick(inputs[i].first, inputs[i].second);
+      if (sim.getNinja()->hasDied() || sim.getNinja()->hasWon())
+      {
+        sim.reset();
+      }
+      long count = allocations.load() - before;
+      if (count != 0 && counting.load())
+      {
+        if (failures++ < 5)
+        {
+          std::fprintf(stderr, "level %u: tick %zu allocated %ld times\n", seed, i, count);
+        }
+      }
+    }
+    return failures;
+  }
+}
+
+int main()
+{
+  SimConfig config;
+  int failures = 0;
+  long ticks = 0;
+  for (unsigned seed = 1; seed <= LEVELS; ++seed)
+  {
+    Simulation sim(config);
+    sim.load(TestLevels::makeLevel(seed));
+    auto inputs = TestLevels::makeInputs(seed, TICKS);
+
+    play(sim, inputs, seed);
+    sim.reset();
+
+    counting = true;
+    failures += play(sim, inputs, seed);
+    counting = false;
+    ticks += TICKS;
+  }
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "%d of %ld ticks allocated\n", failures, ticks);
+    return 1;
+  }
+  std::printf("%ld ticks on %d levels without allocating\n", ticks, LEVELS);
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,189 @@
+// Replays recorded inputs and checks the ninja's trajectory bit for bit
+// against the recording, so any change to the physics that alters a single
+// rounding shows up here. The fixtures in tests/fixtures were recorded with
+// --record at the user-005 fix that made Entity::getType return the entity
+// type, the last change meant to alter trajectories; every later change
+// replays them unchanged. Changes meant to alter trajectories record them
+// again. Only the float build can match them.
+//
+// Fixture format: a `map` line with the level data in hex, then one line per
+// tick with the horizontal and jump inputs and the bit patterns of the
+// ninja's xpos, ypos, xspeed and yspeed after the tick, in hex. The level is
+// reset after any tick that leaves the ninja dead or winning.
+//
+// run: nclone-replay-test <fixture>...
+// record: nclone-replay-test --record <fixture> <seed> <ticks>
+// (generated level and inputs from test_levels.hpp)
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "test_levels.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  struct TickRecord
+  {
+    int hor;
+    int jump;
+    uint32_t state[4]; // xpos, ypos, xspeed, yspeed
+  };
+
+  struct Fixture
+  {
+    std::vector<uint8_t> mapData;
+    std::vector<TickRecord> ticks;
+  };
+
+  uint32_t bits(float value)
+  {
+    uint32_t result;
+    std::memcpy(&result, &value, sizeof(result));
+    return result;
+  }
+
+  // Tick the simulation and capture the ninja's state, resetting after deaths and wins
+  void step(Simulation &sim, TickRecord &record)
+  {
+    sim.tick(record.hor, record.jump);
+    const Ninja *ninja = sim.getNinja();
+    record.state[0] = bits(ninja->xpos);
+    record.state[1] = bits(ninja->ypos);
+    record.state[2] = bits(ninja->xspeed);
+    record.state[3] = bits(ninja->yspeed);
+    if (ninja->hasDied() || ninja->hasWon())
+    {
+      sim.reset();
+    }
+  }
+
+  bool readFixture(const char *path, Fixture &fixture)
+  {
+    std::ifstream file(path);
+    std::string line;
+    while (std::getline(file, line))
+    {
+      if (line.empty() || line[0] == '#')
+      {
+        continue;
+      }
+      std::istringstream fields(line);
+      if (line.compare(0, 4, "map ") == 0)
+      {
+        std::string hex;
+        fields >> hex >> hex;
+        for (size_t i = 0; i + 1 < hex.size(); i += 2)
+        {
+          fixture.mapData.push_back(static_cast<uint8_t>(std::stoul(hex.substr(i, 2), nullptr, 16)));
+        }
+        continue;
+      }
+      TickRecord record;
+      fields >> record.hor >> record.jump >> std::hex >> record.state[0] >> record.state[1] >> record.state[2] >> record.state[3];
+      if (!fields)
+      {
+        std::fprintf(stderr, "%s: malformed line: %s\n", path, line.c_str());
+        return false;
+      }
+      fixture.ticks.push_back(record);
+    }
+    if (fixture.mapData.empty() || fixture.ticks.empty())
+    {
+      std::fprintf(stderr, "%s: missing level data or ticks\n", path);
+      return false;
+    }
+    return true;
+  }
+
+  int record(const char *path, unsigned seed, int ticks)
+  {
+    SimConfig config;
+    Simulation sim(config);
+    auto mapData = TestLevels::makeLevel(seed);
+    sim.load(mapData);
+
+    std::ofstream file(path);
+    file << "# Generated level " << seed << ", " << ticks << " ticks\nmap ";
+    char hex[16];
+    for (uint8_t byte : mapData)
+    {
+      std::snprintf(hex, sizeof(hex), "%02x", byte);
+      file << hex;
+    }
+    file << "\n";
+
+    char line[64];
+    for (const auto &[hor, jump] : TestLevels::makeInputs(seed, ticks))
+    {
+      TickRecord tick{hor, jump, {}};
+      step(sim, tick);
+      std::snprintf(line, sizeof(line), "%d %d %08x %08x %08x %08x\n", tick.hor, tick.jump,
+                    tick.state[0], tick.state[1], tick.state[2], tick.state[3]);
+      file << line;
+    }
+    return file ? 0 : 1;
+  }
+
+  // Returns whether the replay matched the whole recording
+  bool replay(const char *path)
+  {
+    Fixture fixture;
+    if (!readFixture(path, fixture))
+    {
+      return false;
+    }
+
+    SimConfig config;
+    Simulation sim(config);
+    sim.load(fixture.mapData);
+    static const char *NAMES[] = {"xpos", "ypos", "xspeed", "yspeed"};
+    for (size_t i = 0; i < fixture.ticks.size(); ++i)
+    {
+      const TickRecord &expected = fixture.ticks[i];
+      TickRecord actual{expected.hor, expected.jump, {}};
+      step(sim, actual);
+      for (int field = 0; field < 4; ++field)
+      {
+        if (actual.state[field] != expected.state[field])
+        {
+          std::fprintf(stderr, "%s: tick %zu: %s is %08x, recorded %08x\n", path, i, NAMES[field],
+                       actual.state[field], expected.state[field]);
+          return false;
+        }
+      }
+    }
+    std::printf("%s: %zu ticks match\n", path, fixture.ticks.size());
+    return true;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  static_assert(sizeof(Real) == sizeof(float), "the fixtures hold float trajectories");
+
+  if (argc == 5 && std::strcmp(argv[1], "--record") == 0)
+  {
+    return record(argv[2], std::strtoul(argv[3], nullptr, 10), std::atoi(argv[4]));
+  }
+  if (argc < 2)
+  {
+    std::fprintf(stderr, "usage: %s <fixture>... | --record <fixture> <seed> <ticks>\n", argv[0]);
+    return 2;
+  }
+
+  int failures = 0;
+  for (int i = 1; i < argc; ++i)
+  {
+    failures += !replay(argv[i]);
+  }
+  return failures > 0 ? 1 : 0;
+}
\ No newline at end of file
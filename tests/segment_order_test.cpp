@@ -0,0 +1,99 @@
+// Pins the order in which CompiledMap stages the tile linears of each cell:
+// the tile's diagonal first, then the horizontal segments in row-major order
+// of their half-cell position, then the vertical ones in the same order.
+// Closest point queries keep the first of equally close segments, so this
+// order decides ties, and changing it changes trajectories. The hash map grids
+// of the original C++ port visited the segments in an order that depended on
+// the standard library's hashing and on previous map loads; the dense grids
+// replaced it with this one.
+//
+// run: nclone-segment_order-test [levels]
+
+#include "compiled_map.hpp"
+#include "test_levels.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  enum class Kind
+  {
+    Diagonal,
+    Horizontal,
+    Vertical
+  };
+
+  // Kind of a linear, and the (row, column) of its half-cell position
+  std::pair<Kind, std::pair<int, int>> classify(const GridSegmentLinear &segment)
+  {
+    Real x1 = segment.getX1(), y1 = segment.getY1(), x2 = segment.getX2(), y2 = segment.getY2();
+    if (y1 == y2)
+    {
+      return {Kind::Horizontal, {static_cast<int>(y1 / 12), static_cast<int>(std::min(x1, x2) / 12)}};
+    }
+    if (x1 == x2)
+    {
+      return {Kind::Vertical, {static_cast<int>(std::min(y1, y2) / 12), static_cast<int>(x1 / 12)}};
+    }
+    return {Kind::Diagonal, {0, 0}};
+  }
+
+  // Returns the number of cells whose linears are out of order
+  int checkLevel(const char *name, const std::vector<uint8_t> &mapData)
+  {
+    CompiledMap map(mapData);
+    int failures = 0;
+    for (int y = 0; y < 25; ++y)
+    {
+      for (int x = 0; x < 44; ++x)
+      {
+        std::vector<std::pair<Kind, std::pair<int, int>>> order;
+        map.getSegments().forEachLinearInCell({x, y}, [&](const GridSegmentLinear &segment)
+                                              { order.push_back(classify(segment)); });
+        if (!std::is_sorted(order.begin(), order.end()) ||
+            std::count_if(order.begin(), order.end(), [](const auto &entry)
+                          { return entry.first == Kind::Diagonal; }) > 1)
+        {
+          if (failures++ < 5)
+          {
+            std::fprintf(stderr, "%s: linears of cell (%d, %d) are not in staging order\n", name, x, y);
+          }
+        }
+      }
+    }
+    return failures;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int levels = argc > 1 ? std::atoi(argv[1]) : 20;
+
+  int failures = 0;
+  char name[32];
+  for (unsigned seed = 1; seed <= static_cast<unsigned>(levels); ++seed)
+  {
+    std::snprintf(name, sizeof(name), "level %u", seed);
+    failures += checkLevel(name, TestLevels::makeLevel(seed));
+  }
+
+  // Every tile id side by side, so each shape meets every other one
+  std::vector<uint8_t> mapData(1235, 0);
+  for (int i = 0; i < 42 * 23; ++i)
+  {
+    mapData[184 + i] = (i * 7 + i / 42) % CompiledMap::TILE_TYPE_COUNT;
+  }
+  failures += checkLevel("all tile ids", mapData);
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "%d cells out of order\n", failures);
+    return 1;
+  }
+  std::printf("%d levels stage their segments in row-major order\n", levels + 1);
+  return 0;
+}
\ No newline at end of file
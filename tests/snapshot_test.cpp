@@ -0,0 +1,172 @@
+// Checks that Simulation::restore puts back exactly the state
+// Simulation::snapshot captured. A snapshot is taken partway through a
+// generated level; the ticks that follow are replayed after restoring it into
+// the same simulation and into a second one that loaded the same level, and
+// every entity's and the ninja's state must match the first run bit for bit.
+// Restoring a state into a simulation on another level must throw.
+//
+// run: nclone-snapshot-test [levels] [ticks]
+
+#include "simulation.hpp"
+#include "simulation_state.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "entities/entity.hpp"
+#include "entities/exit_switch.hpp"
+#include "test_levels.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace
+{
+  constexpr int TYPE_COUNT = 29;
+
+  // FNV-1a over the ninja's and every entity's position, speed and active flag
+  uint64_t hashState(const Simulation &sim)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t size)
+    {
+      const unsigned char *bytes = static_cast<const unsigned char *>(data);
+      for (size_t i = 0; i < size; ++i)
+      {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+      }
+    };
+    const Ninja *ninja = sim.getNinja();
+    for (Real value : {ninja->xpos, ninja->ypos, ninja->xspeed, ninja->yspeed})
+    {
+      mix(&value, sizeof(value));
+    }
+    int state = ninja->getState();
+    mix(&state, sizeof(state));
+    for (int type = 0; type < TYPE_COUNT; ++type)
+    {
+      for (const Entity *entity : sim.getEntitiesOfType(type))
+      {
+        for (Real value : {entity->getXPos(), entity->getYPos(), entity->getXSpeed(), entity->getYSpeed()})
+        {
+          mix(&value, sizeof(value));
+        }
+        bool active = entity->isActive();
+        mix(&active, sizeof(active));
+      }
+    }
+    return hash;
+  }
+
+  // State hash after every tick, resetting after deaths and wins
+  std::vector<uint64_t> play(Simulation &sim, const std::vector<std::pair<int, int>> &inputs)
+  {
+    std::vector<uint64_t> hashes;
+    for (const auto &[hor, jump] : inputs)
+    {
+      sim.tick(hor, jump);
+      hashes.push_back(hashState(sim));
+      if (sim.getNinja()->hasDied() || sim.getNinja()->hasWon())
+      {
+        sim.reset();
+      }
+    }
+    return hashes;
+  }
+
+  // Whether every entity and exit switch link points into sim
+  bool ownsEntities(Simulation &sim)
+  {
+    for (int type = 0; type < TYPE_COUNT; ++type)
+    {
+      for (Entity *entity : sim.getEntitiesOfType(type))
+      {
+        if (entity->getSimulation() != &sim)
+        {
+          return false;
+        }
+        if (type == ExitSwitch::ENTITY_TYPE && static_cast<ExitSwitch *>(entity)->getParent()->getSimulation() != &sim)
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  int compare(unsigned seed, const char *what, const std::vector<uint64_t> &expected, const std::vector<uint64_t> &actual)
+  {
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+      if (actual[i] != expected[i])
+      {
+        std::fprintf(stderr, "level %u: %s diverges at tick %zu after the snapshot\n", seed, what, i);
+        return 1;
+      }
+    }
+    return 0;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int levels = argc > 1 ? std::atoi(argv[1]) : 8;
+  int ticks = argc > 2 ? std::atoi(argv[2]) : 600;
+
+  SimConfig config;
+  int failures = 0;
+  for (unsigned seed = 1; seed <= static_cast<unsigned>(levels); ++seed)
+  {
+    auto mapData = TestLevels::makeLevel(seed);
+    auto inputs = TestLevels::makeInputs(seed, ticks);
+    std::vector<std::pair<int, int>> before(inputs.begin(), inputs.begin() + ticks / 3);
+    std::vector<std::pair<int, int>> after(inputs.begin() + ticks / 3, inputs.end());
+
+    Simulation sim(config);
+    sim.load(mapData);
+    play(sim, before);
+    SimulationState state;
+    sim.snapshot(state);
+    auto expected = play(sim, after);
+
+    // The same simulation, moved on by the first run
+    sim.restore(state);
+    failures += compare(seed, "restore", expected, play(sim, after));
+
+    // A second simulation of the same level, moved elsewhere first
+    Simulation other(config);
+    other.load(mapData);
+    play(other, TestLevels::makeInputs(seed + 100, ticks / 2));
+    other.restore(state);
+    if (!ownsEntities(other))
+    {
+      std::fprintf(stderr, "level %u: restored entities still point into the snapshot's simulation\n", seed);
+      ++failures;
+    }
+    failures += compare(seed, "restore into another simulation", expected, play(other, after));
+
+    // A simulation of another level must refuse the state
+    Simulation elsewhere(config);
+    elsewhere.load(TestLevels::makeLevel(seed + 1000));
+    try
+    {
+      elsewhere.restore(state);
+      std::fprintf(stderr, "level %u: a state restored into a simulation of another level\n", seed);
+      ++failures;
+    }
+    catch (const std::invalid_argument &)
+    {
+    }
+  }
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "%d snapshot checks failed\n", failures);
+    return 1;
+  }
+  std::printf("%d levels restore bit for bit\n", levels);
+  return 0;
+}
\ No newline at end of file
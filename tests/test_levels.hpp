@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <random>
+#include <utility>
+#include <vector>
+
+// Generated levels and inputs shared by the tests
+namespace TestLevels
+{
+  // Entity types placed on the levels: mines, gold, doors, launch pads,
+  // one way platforms, drones, bounce blocks, thwumps, boost pads, death
+  // balls and mini drones. Locked and trap doors get a switch record after them.
+  constexpr int ENTITY_TYPES[] = {1, 2, 2, 2, 5, 6, 8, 10, 11, 14, 17, 20, 21, 24, 25, 26, 28};
+
+  // A level of random tiles with an exit, its switch and `entities` random
+  // entities. Tiles of the 42x23 playable area start at byte 184, the ninja
+  // spawn is at 1231 and entity records of 5 bytes follow from 1235.
+  // Positions are in units of 6 pixels. The cells around the spawn are empty.
+  inline std::vector<uint8_t> makeLevel(unsigned seed, int entities = 40)
+  {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> mapData(1235, 0);
+    int spawnX = 5 + rng() % 30, spawnY = 5 + rng() % 12;
+    for (int y = 0; y < 23; ++y)
+    {
+      for (int x = 0; x < 42; ++x)
+      {
+        int roll = rng() % 100;
+        int tile = roll < 10 ? 1 : roll < 16 ? 2 + rng() % 32 : 0;
+        bool spawn = std::abs(x - spawnX) <= 2 && std::abs(y - spawnY) <= 2;
+        mapData[184 + x + y * 42] = spawn ? 0 : tile;
+      }
+    }
+    mapData[1231] = (spawnX + 1) * 4 + 2;
+    mapData[1232] = (spawnY + 1) * 4 + 2;
+
+    auto addEntity = [&](int type, int orientation, int mode)
+    {
+      uint8_t x = 8 + rng() % 160, y = 8 + rng() % 88;
+      mapData.insert(mapData.end(), {static_cast<uint8_t>(type), x, y, static_cast<uint8_t>(orientation), static_cast<uint8_t>(mode)});
+    };
+    mapData[1156] = 1; // Exit door count
+    addEntity(3, 0, 0);
+    addEntity(4, 0, 0);
+    for (int i = 0; i < entities; ++i)
+    {
+      int type = ENTITY_TYPES[rng() % std::size(ENTITY_TYPES)];
+      bool orthogonal = type == 5 || type == 6 || type == 8 || type == 11 || type == 14 || type == 20 || type == 26;
+      int orientation = orthogonal ? 2 * (rng() % 4) : rng() % 8;
+      addEntity(type, orientation, rng() % 2);
+      if (type == 6 || type == 8)
+      {
+        addEntity(0, 0, 0);
+      }
+    }
+    return mapData;
+  }
+
+  // Random (horizontal, jump) inputs, each held for 1 to 20 ticks
+  inline std::vector<std::pair<int, int>> makeInputs(unsigned seed, int ticks)
+  {
+    std::mt19937 rng(seed);
+    std::vector<std::pair<int, int>> inputs;
+    while (static_cast<int>(inputs.size()) < ticks)
+    {
+      std::pair<int, int> input{static_cast<int>(rng() % 3) - 1, static_cast<int>(rng() % 2)};
+      inputs.insert(inputs.end(), 1 + rng() % 20, input);
+    }
+    inputs.resize(ticks);
+    return inputs;
+  }
+}
\ No newline at end of file
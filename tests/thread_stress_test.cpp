@@ -0,0 +1,96 @@
+// Ticks one Simulation per thread, all at once, and checks that every
+// trajectory matches a serial run of the same level and inputs. Separate
+// simulations share no mutable state, so the results must be identical, and
+// a build with -DNCLONE_SANITIZE_THREAD=ON must run this without reports.
+//
+// run: nclone-thread_stress-test [threads] [ticks]
+
+#include "simulation.hpp"
+#include "sim_config.hpp"
+#include "ninja.hpp"
+#include "test_levels.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // FNV-1a over the ninja's position and speed after every tick
+  uint64_t play(const SimConfig &config, unsigned seed, int ticks)
+  {
+    Simulation sim(config);
+    sim.load(TestLevels::makeLevel(seed));
+    auto inputs = TestLevels::makeInputs(seed, ticks);
+
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](Real value)
+    {
+      unsigned char bytes[sizeof(Real)];
+      std::memcpy(bytes, &value, sizeof(Real));
+      for (unsigned char byte : bytes)
+      {
+        hash = (hash ^ byte) * 1099511628211ull;
+      }
+    };
+    for (const auto &[hor, jump] : inputs)
+    {
+      sim.tick(hor, jump);
+      const Ninja *ninja = sim.getNinja();
+      mix(ninja->xpos);
+      mix(ninja->ypos);
+      mix(ninja->xspeed);
+      mix(ninja->yspeed);
+      if (ninja->hasDied() || ninja->hasWon())
+      {
+        sim.reset();
+      }
+    }
+    return hash;
+  }
+}
+
+int main(int argc, char **argv)
+{
+  int threads = argc > 1 ? std::atoi(argv[1]) : 8;
+  int ticks = argc > 2 ? std::atoi(argv[2]) : 2000;
+
+  // The config is only read, so all the simulations share it
+  SimConfig config;
+  std::vector<uint64_t> serial(threads);
+  for (int i = 0; i < threads; ++i)
+  {
+    serial[i] = play(config, i + 1, ticks);
+  }
+
+  std::vector<uint64_t> parallel(threads);
+  std::vector<std::thread> workers;
+  for (int i = 0; i < threads; ++i)
+  {
+    workers.emplace_back([&, i]
+                         { parallel[i] = play(config, i + 1, ticks); });
+  }
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  int failures = 0;
+  for (int i = 0; i < threads; ++i)
+  {
+    if (parallel[i] != serial[i])
+    {
+      std::fprintf(stderr, "level %d: threaded trajectory differs from the serial run\n", i + 1);
+      ++failures;
+    }
+  }
+  if (failures > 0)
+  {
+    return 1;
+  }
+  std::printf("%d simulations matched their serial runs over %d ticks\n", threads, ticks);
+  return 0;
+}
\ No newline at end of file
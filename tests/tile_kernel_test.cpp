@@ -0,0 +1,159 @@
+// Checks the per tile id collision kernels of tile_segments.hpp against the
+// segments the compiled map stores for the same tile. For every tile id from
+// 0 to 37, the tile is placed alone on a level; its kernel must answer every
+// closest point query on a grid of positions around the cell, and for arcs
+// every sweep from those positions, bit for bit like the GridSegmentLinear or
+// GridSegmentCircular of the segment store. Tiles without a slope or an arc
+// must have no kernel.
+
+#include "compiled_map.hpp"
+#include "physics/tile_segments.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <tuple>
+#include <vector>
+
+namespace
+{
+  // Playable tile (10, 10), which is cell (11, 11) of the grids
+  constexpr int TILE_X = 10;
+  constexpr int TILE_Y = 10;
+  const TileSegments::CellCoord CELL{TILE_X + 1, TILE_Y + 1};
+
+  // Move vectors and circle radii of the sweeps: rays, the ninja and larger circles
+  constexpr Real MOVES[][2] = {{0, 0}, {3, 0}, {-3, 0}, {0, 3}, {0, -3}, {2.5f, -1.75f}, {-4, 6.5f}, {-0.01f, 0.02f}, {30, 24}};
+  constexpr Real RADII[] = {0, 5, 10, 12};
+
+  bool same(Real a, Real b)
+  {
+    return std::memcmp(&a, &b, sizeof(Real)) == 0;
+  }
+
+  struct Checker
+  {
+    int tileId;
+    long checks = 0;
+    int failures = 0;
+
+    void fail(const char *what, Real xpos, Real ypos)
+    {
+      if (failures++ < 5)
+      {
+        std::fprintf(stderr, "tile %d: %s differs at (%.3f, %.3f)\n", tileId, what, xpos, ypos);
+      }
+    }
+
+    // Positions from a cell beyond each side of the tile's cell, on a grid
+    // that is not aligned with the tile geometry, plus the exact corners
+    template <typename Check>
+    void forEachPosition(Check &&check)
+    {
+      Real left = CELL.first * 24, top = CELL.second * 24;
+      for (Real y = top - 24; y <= top + 48; y += Real(1.75))
+      {
+        for (Real x = left - 24; x <= left + 48; x += Real(1.75))
+        {
+          check(x, y);
+        }
+      }
+      for (int corner = 0; corner < 4; ++corner)
+      {
+        check(left + 24 * (corner % 2), top + 24 * (corner / 2));
+      }
+    }
+
+    template <typename Kernel, typename Generic>
+    void compareClosestPoints(const Kernel &kernel, const Generic &generic)
+    {
+      forEachPosition([&](Real xpos, Real ypos)
+                      {
+        auto [kernelBack, kernelA, kernelB] = kernel.getClosestPoint(xpos, ypos);
+        auto [genericBack, genericA, genericB] = generic.getClosestPoint(xpos, ypos);
+        ++checks;
+        if (kernelBack != genericBack || !same(kernelA, genericA) || !same(kernelB, genericB))
+        {
+          fail("closest point", xpos, ypos);
+        } });
+    }
+
+    template <typename Kernel, typename Generic>
+    void compareSweeps(const Kernel &kernel, const Generic &generic)
+    {
+      forEachPosition([&](Real xpos, Real ypos)
+                      {
+        for (const auto &move : MOVES)
+        {
+          for (Real radius : RADII)
+          {
+            ++checks;
+            if (!same(kernel.intersectWithRay(xpos, ypos, move[0], move[1], radius),
+                      generic.intersectWithRay(xpos, ypos, move[0], move[1], radius)))
+            {
+              fail("sweep", xpos, ypos);
+            }
+          }
+        } });
+    }
+  };
+}
+
+int main()
+{
+  int failures = 0;
+  long checks = 0;
+  for (int tileId = 0; tileId < CompiledMap::TILE_TYPE_COUNT; ++tileId)
+  {
+    std::vector<uint8_t> mapData(1235, 0);
+    mapData[184 + TILE_X + TILE_Y * 42] = tileId;
+    CompiledMap map(mapData);
+    const SegmentStore &store = map.getSegments();
+
+    // The store lists a tile's slope first among the linears of its cell and
+    // holds at most one arc per cell
+    std::vector<GridSegmentLinear> linears;
+    std::vector<GridSegmentCircular> circulars;
+    store.forEachLinearInCell(CELL, [&](const GridSegmentLinear &segment)
+                              { linears.push_back(segment); });
+    store.forEachCircularInCell(CELL, [&](const GridSegmentCircular &segment)
+                                { circulars.push_back(segment); });
+
+    Checker checker{tileId};
+    int linearKernels = 0, circularKernels = 0;
+    TileSegments::forEachLinearInCell(tileId, CELL, [&](const auto &kernel)
+                                      {
+      ++linearKernels;
+      if (!linears.empty())
+      {
+        checker.compareClosestPoints(kernel, linears.front());
+      } });
+    TileSegments::forEachCircularInCell(tileId, CELL, [&](const auto &kernel)
+                                        {
+      ++circularKernels;
+      if (!circulars.empty())
+      {
+        checker.compareClosestPoints(kernel, circulars.front());
+        checker.compareSweeps(kernel, circulars.front());
+      } });
+
+    bool hasSlope = CompiledMap::TILE_SHAPES[tileId] == TileShape::Slope;
+    if (linearKernels != (hasSlope ? 1 : 0) || circularKernels != static_cast<int>(circulars.size()) ||
+        (hasSlope && linears.empty()))
+    {
+      std::fprintf(stderr, "tile %d: %d slope and %d arc kernels for %zu linears and %zu arcs in the store\n",
+                   tileId, linearKernels, circularKernels, linears.size(), circulars.size());
+      ++checker.failures;
+    }
+    failures += checker.failures;
+    checks += checker.checks;
+  }
+
+  if (failures > 0)
+  {
+    std::fprintf(stderr, "%d of %ld kernel results differ\n", failures, checks);
+    return 1;
+  }
+  std::printf("%ld kernel results match the stored segments\n", checks);
+  return 0;
+}
\ No newline at end of file